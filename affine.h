@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file affine.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 二次元のアフィン變換行列
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_AFFINE_H
+#define INCLUDE_GUARD_EUNOMIA_AFFINE_H
+
+#include <cmath>
+#include <optional>
+
+
+namespace eunomia
+{
+
+/**
+ * @brief 二次元のアフィン變換行列
+ *
+ * 點(x, y)を
+ * (a * x + b * y + tx, c * x + d * y + ty)
+ * に寫す。
+ * 畫像の座標系(Y軸が下向き)で用ゐることを前提とする。
+ *
+ * 例へば幅w、高さhの畫像をその中心の周りにthetaだけ回轉し、
+ * 中心が(px, py)に來るやうに配置する行列は
+ * translation(px, py) * rotation(theta) * translation(-w / 2.0, -h / 2.0)
+ * で得られる。
+ */
+struct AffineMatrix
+{
+  double a = 1.0;
+  double b = 0.0;
+  double c = 0.0;
+  double d = 1.0;
+  double tx = 0.0;
+  double ty = 0.0;
+
+  /// @brief 恆等變換
+  static constexpr AffineMatrix identity() noexcept
+  {
+    return AffineMatrix{};
+  }
+
+  /// @brief 平行移動
+  static constexpr AffineMatrix translation(double x, double y) noexcept
+  {
+    return AffineMatrix{1.0, 0.0, 0.0, 1.0, x, y};
+  }
+
+  /// @brief 擴大縮小
+  static constexpr AffineMatrix scaling(double sx, double sy) noexcept
+  {
+    return AffineMatrix{sx, 0.0, 0.0, sy, 0.0, 0.0};
+  }
+
+  /// @brief 原點の周りの回轉
+  ///
+  /// Y軸が下向きの座標系では、正の角度で時計回りに回轉する。
+  /// @param radian 回轉角(ラジアン)
+  static AffineMatrix rotation(double radian) noexcept
+  {
+    double cs = std::cos(radian);
+    double sn = std::sin(radian);
+    return AffineMatrix{cs, -sn, sn, cs, 0.0, 0.0};
+  }
+
+  /// @brief 剪斷
+  ///
+  /// 點(x, y)を(x + kx * y, ky * x + y)に寫す。
+  static constexpr AffineMatrix shearing(double kx, double ky) noexcept
+  {
+    return AffineMatrix{1.0, kx, ky, 1.0, 0.0, 0.0};
+  }
+
+  /// @brief 合成
+  ///
+  /// otherを施した後に*thisを施す變換を返す。
+  constexpr AffineMatrix operator*(const AffineMatrix& o) const noexcept
+  {
+    return
+      AffineMatrix{
+        a * o.a + b * o.c, a * o.b + b * o.d,
+        c * o.a + d * o.c, c * o.b + d * o.d,
+        a * o.tx + b * o.ty + tx, c * o.tx + d * o.ty + ty};
+  }
+
+  /// @brief 行列式
+  constexpr double determinant() const noexcept { return a * d - b * c; }
+
+  /// @brief 逆變換
+  ///
+  /// 逆變換が存在しない場合はstd::nulloptを返す。
+  std::optional<AffineMatrix> inverse() const noexcept
+  {
+    double det = determinant();
+    if (det == 0.0 || !std::isfinite(det))
+      return std::nullopt;
+
+    double ia = d / det;
+    double ib = -b / det;
+    double ic = -c / det;
+    double id = a / det;
+    return
+      AffineMatrix{
+        ia, ib, ic, id, -(ia * tx + ib * ty), -(ic * tx + id * ty)};
+  }
+
+  /// @brief 點(x, y)の寫像のX座標
+  constexpr double mapX(double x, double y) const noexcept
+  {
+    return a * x + b * y + tx;
+  }
+
+  /// @brief 點(x, y)の寫像のY座標
+  constexpr double mapY(double x, double y) const noexcept
+  {
+    return c * x + d * y + ty;
+  }
+};
+
+
+}//end of namespace eunomia
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_AFFINE_H
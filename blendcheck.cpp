@@ -0,0 +1,466 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file blendcheck.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ブレンド用函數オブジェクトの1ライン單位の轉送の檢査用のプログラム
+ *
+ * 各copierの1ライン單位の轉送(SSE2、AVX2による處理と半端な畫素の處理)が
+ * 一畫素づつ轉送した場合と一致することを確かめる。
+ * CompositeCopierについては、一畫素づつ轉送した結果が
+ * 倍精度浮動小數點數で計算した値の四捨五入と一致することも確かめる。
+ * 各要素とアルファ値に境界附近の値を組み合はせた畫素と亂數による畫素を、
+ * 樣々な長さと開始位置のラインで轉送して比較する。
+ * PictureIndexedからの轉送は、亂數によるパレットとインデックスで確かめる。
+ * 乘算濟みアルファから乘算濟みでないアルファへの變換については、
+ * 色要素とアルファ値の全ての組合はせで畫素毎の變換と一致することを確かめる。
+ * 全て一致すれば0を、さもなくば1を返す。
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "colour.h"
+#include "picture_indexed.h"
+#include "picture_rgba.h"
+#include "picture_rgba_premul.h"
+
+
+namespace {
+
+/// 境界附近の値
+constexpr int EDGES[] = { 0, 1, 2, 127, 128, 129, 253, 254, 255 };
+constexpr int NEDGES = sizeof(EDGES) / sizeof(EDGES[0]);
+
+/// 亂數で作る畫素の組の數
+constexpr int RANDOM_PAIRS = 5000;
+
+/// 轉送するラインの最大長(CHUNK_を跨ぐ長さも含める)
+constexpr int MAX_LENGTH = 70;
+constexpr int LONG_LENGTHS[] = { 64, 65, 127, 128, 129, 200 };
+
+
+/// 轉送元と轉送先の一組の畫素(各4要素)
+struct Pair
+{
+  std::uint8_t s[4];
+  std::uint8_t d[4];
+};
+
+
+/// @brief 檢査に用ゐる畫素の組
+///
+/// 各要素毎に(轉送元の値、轉送元のアルファ値、轉送先の値、轉送先のアルファ値)
+/// の境界附近の値の全ての組合はせを含む。
+/// 緑と青には赤と異なる順序で組合はせを割り當てる。
+std::vector<Pair> makePairs()
+{
+  std::vector<Pair> pairs;
+  const int n4 = NEDGES * NEDGES * NEDGES * NEDGES;
+  for (int k = 0; k < n4; ++k) {
+    int i = k;
+    int sc = EDGES[i % NEDGES]; i /= NEDGES;
+    int sa = EDGES[i % NEDGES]; i /= NEDGES;
+    int dc = EDGES[i % NEDGES]; i /= NEDGES;
+    int da = EDGES[i % NEDGES];
+    int g = EDGES[(k * 7 + 3) % NEDGES];
+    int b = EDGES[(k * 5 + 1) % NEDGES];
+
+    Pair p;
+    p.s[0] = sc; p.s[1] = g; p.s[2] = b; p.s[3] = sa;
+    p.d[0] = dc; p.d[1] = b; p.d[2] = g; p.d[3] = da;
+    pairs.push_back(p);
+  }
+
+  std::mt19937 rng(20261017);
+  for (int k = 0; k < RANDOM_PAIRS; ++k) {
+    Pair p;
+    for (int c = 0; c < 4; ++c) {
+      p.s[c] = rng() & 0xFF;
+      p.d[c] = rng() & 0xFF;
+    }
+    pairs.push_back(p);
+  }
+  return pairs;
+}
+
+
+/// 4要素から畫素を作る
+template<class C>
+C toPixel(const std::uint8_t* v)
+{
+  if constexpr (sizeof(C) == 3)
+    return C(v[0], v[1], v[2]);
+  else
+    return C(v[0], v[1], v[2], v[3]);
+}
+
+
+/// 乘算濟みの値として正しくなるやう、色要素をアルファ値以下にする
+void premultiplied(std::uint8_t* v)
+{
+  for (int c = 0; c < 3; ++c)
+    v[c] = std::min(v[c], v[3]);
+}
+
+
+/// 檢査結果
+int failures = 0;
+
+
+/// @brief 1ライン單位の轉送と一畫素づつの轉送の比較
+///
+/// srcとdstを長さnのラインに區切り、ライン毎に兩方の轉送を行つて比較する。
+/// 開始位置をずらすため、先頭のoffset畫素は飛ばす。
+/// keepAlphaが眞ならば、1ライン單位の轉送が轉送先のアルファ値を
+/// 變更しないことも確かめる。
+/// @return 一致しなかつた(長さ、開始位置)の數
+template<class CSrc, class CDst, class Copier>
+int compareRows(
+  const std::string& name, Copier& copier,
+  const std::vector<CSrc>& src, const std::vector<CDst>& dst,
+  bool keepAlpha = false)
+{
+  std::vector<int> lengths;
+  for (int n = 1; n <= MAX_LENGTH; ++n)
+    lengths.push_back(n);
+  lengths.insert(
+    lengths.end(), std::begin(LONG_LENGTHS), std::end(LONG_LENGTHS));
+
+  int bad = 0;
+  std::vector<CDst> rowed(dst.size()), single(dst.size());
+  for (int n : lengths) {
+    for (int offset = 0; offset < 2; ++offset) {
+      rowed = dst;
+      single = dst;
+      std::size_t i = offset;
+      for (; i + n <= src.size(); i += n) {
+        copier(src.data() + i, rowed.data() + i, n);
+        for (std::size_t j = i; j < i + n; ++j)
+          copier(src[j], single[j]);
+      }
+
+      bool ok
+        = std::memcmp(rowed.data(), single.data(), sizeof(CDst) * i) == 0;
+      if constexpr (sizeof(CDst) == 4) {
+        if (keepAlpha)
+          for (std::size_t j = 0; j < i; ++j)
+            if (rowed[j].alpha != dst[j].alpha)
+              ok = false;
+      }
+
+      if (!ok && bad++ < 3)
+        std::cerr << name << ": mismatch (n = " << n
+                  << ", offset = " << offset << ")" << std::endl;
+    }
+  }
+  return bad;
+}
+
+
+/// 檢査結果の表示と記録
+void report(const std::string& name, int bad)
+{
+  std::cout << (bad ? "NG " : "ok ") << name << std::endl;
+  if (bad)
+    ++failures;
+}
+
+
+/// @brief 畫素の組による1ライン單位の轉送の檢査
+///
+/// pairsから轉送元と轉送先の畫素を作つてcompareRows()で比較する。
+template<class CSrc, class CDst, class Copier>
+void checkRows(
+  const std::string& name, Copier copier, const std::vector<Pair>& pairs,
+  bool premul)
+{
+  std::vector<CSrc> src;
+  std::vector<CDst> dst;
+  for (const auto& p : pairs) {
+    Pair q = p;
+    if (premul) {
+      premultiplied(q.s);
+      premultiplied(q.d);
+    }
+    src.push_back(toPixel<CSrc>(q.s));
+    dst.push_back(toPixel<CDst>(q.d));
+  }
+
+  report(name, compareRows(name, copier, src, dst));
+}
+
+
+/// @brief パレットの展開の檢査
+///
+/// 亂數によるパレットを持つPictureIndexedから
+/// NormalBrendCopierFromPictureIndexedを作り、
+/// 亂數によるインデックスをpairsの轉送先の畫素に轉送して比較する。
+/// 轉送先がRgbaColourの場合は、アルファ値が變更されないことも確かめる。
+template<class CDst>
+void checkIndexed(const std::string& name, const std::vector<Pair>& pairs)
+{
+  constexpr int PALETTES = 4;
+
+  auto pict = eunomia::PictureIndexed::create(1, 1);
+  if (!pict) {
+    report(name + " (allocation)", 1);
+    return;
+  }
+
+  std::mt19937 rng(20261017);
+  std::vector<CDst> dst;
+  for (const auto& p : pairs)
+    dst.push_back(toPixel<CDst>(p.d));
+
+  int bad = 0;
+  for (int k = 0; k < PALETTES; ++k) {
+    for (int i = 0; i < 256; ++i)
+      pict->palette(i)
+        = eunomia::RgbColour(rng() & 0xFF, rng() & 0xFF, rng() & 0xFF);
+    eunomia::NormalBrendCopierFromPictureIndexed copier(*pict);
+
+    std::vector<std::uint8_t> src;
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+      src.push_back(rng() & 0xFF);
+
+    bad += compareRows(name, copier, src, dst, true);
+  }
+
+  report(name, bad);
+}
+
+
+/// @brief 合成演算子の參照實裝
+///
+/// 各値を0〜1の實數として CompositeOp の定義通りに計算し、
+/// 255倍して四捨五入する。
+template<eunomia::CompositeOp OP>
+int reference(int s8, int d8, int sa8, int da8)
+{
+  using eunomia::CompositeOp;
+
+  double s = s8 / 255.0;
+  double d = d8 / 255.0;
+  double sa = sa8 / 255.0;
+  double da = da8 / 255.0;
+
+  double x = 0.0;
+  if constexpr (OP == CompositeOp::Src)
+    x = s;
+  else if constexpr (OP == CompositeOp::Over)
+    x = s + d * (1.0 - sa);
+  else if constexpr (OP == CompositeOp::DstOver)
+    x = d + s * (1.0 - da);
+  else if constexpr (OP == CompositeOp::In)
+    x = s * da;
+  else if constexpr (OP == CompositeOp::Out)
+    x = s * (1.0 - da);
+  else if constexpr (OP == CompositeOp::Atop)
+    x = s * da + d * (1.0 - sa);
+  else if constexpr (OP == CompositeOp::Xor)
+    x = s * (1.0 - da) + d * (1.0 - sa);
+  else if constexpr (OP == CompositeOp::Screen)
+    x = s + d - s * d;
+  else if constexpr (OP == CompositeOp::Overlay)
+    x = s * (1.0 - da) + d * (1.0 - sa)
+        + (2.0 * d <= da ? 2.0 * s * d : sa * da - 2.0 * (da - d) * (sa - s));
+  else if constexpr (OP == CompositeOp::Darken)
+    x = s + d - std::max(s * da, d * sa);
+  else if constexpr (OP == CompositeOp::Lighten)
+    x = s + d - std::min(s * da, d * sa);
+
+  return std::clamp((int)std::lround(x * 255.0), 0, 255);
+}
+
+
+/// @brief 一畫素づつの合成と參照實裝の比較
+template<eunomia::CompositeOp OP>
+void checkReference(const std::string& name, const std::vector<Pair>& pairs)
+{
+  using eunomia::RgbColour;
+  using eunomia::RgbaPremulColour;
+
+  eunomia::CompositeCopier<OP> copier;
+  int bad = 0;
+  for (const auto& p : pairs) {
+    Pair q = p;
+    premultiplied(q.s);
+    premultiplied(q.d);
+    auto src = toPixel<RgbaPremulColour>(q.s);
+
+    // 乘算濟みアルファの畫素へ
+    auto d4 = toPixel<RgbaPremulColour>(q.d);
+    copier(src, d4);
+    const std::uint8_t got4[] = { d4.red, d4.green, d4.blue, d4.alpha };
+    for (int c = 0; c < 4; ++c) {
+      int sv = c == 3 ? q.s[3] : q.s[c];
+      int dv = c == 3 ? q.d[3] : q.d[c];
+      if (got4[c] != reference<OP>(sv, dv, q.s[3], q.d[3]))
+        ++bad;
+    }
+
+    // 不透明なRGBの畫素へ
+    auto d3 = toPixel<RgbColour>(q.d);
+    copier(src, d3);
+    const std::uint8_t got3[] = { d3.red, d3.green, d3.blue };
+    for (int c = 0; c < 3; ++c)
+      if (got3[c] != reference<OP>(q.s[c], q.d[c], q.s[3], 255))
+        ++bad;
+  }
+
+  report(name + " (reference)", bad);
+}
+
+
+/// @brief 合成演算子OPの檢査
+template<eunomia::CompositeOp OP>
+void checkComposite(const std::string& name, const std::vector<Pair>& pairs)
+{
+  using eunomia::RgbColour;
+  using eunomia::RgbaPremulColour;
+
+  checkReference<OP>(name, pairs);
+
+  eunomia::CompositeCopier<OP> copier;
+  checkRows<RgbaPremulColour, RgbColour>(name + " ->RGB", copier, pairs, true);
+  checkRows<RgbaPremulColour, RgbaPremulColour>(
+    name + " ->Premul", copier, pairs, true);
+}
+
+
+/// @brief 乘算濟みでないアルファへの變換の檢査
+///
+/// 色要素とアルファ値の全ての組合はせ(256×256)について、
+/// convertToStraight()の結果がRgbaPremulColourからRgbaColourへの變換に
+/// 一致することを確かめる。
+void checkStraight()
+{
+  using eunomia::RgbaColour;
+  using eunomia::RgbaPremulColour;
+
+  auto src = eunomia::PictureRgbaPremul::create(256, 256);
+  auto dst = eunomia::PictureRgba::create(256, 256);
+  if (!src || !dst) {
+    report("convertToStraight (allocation)", 1);
+    return;
+  }
+
+  // 行をアルファ値、列を色要素とし、緑と青には赤と異なる値を與へる
+  for (int a = 0; a < 256; ++a)
+    for (int c = 0; c < 256; ++c)
+      src->pixel(c, a) = RgbaPremulColour(c, 255 - c, (c * 7) & 0xFF, a);
+  eunomia::convertToStraight(*src, *dst);
+
+  int bad = 0;
+  for (int a = 0; a < 256; ++a) {
+    for (int c = 0; c < 256; ++c) {
+      auto expected = static_cast<RgbaColour>(src->pixel(c, a));
+      if (dst->pixel(c, a) != expected && bad++ < 3)
+        std::cerr << "convertToStraight: mismatch (c = " << c
+                  << ", a = " << a << ")" << std::endl;
+    }
+  }
+
+  report("convertToStraight", bad);
+}
+
+
+}//end of namespace
+
+
+int main()
+{
+  using eunomia::RgbColour;
+  using eunomia::RgbaColour;
+  using eunomia::RgbaPremulColour;
+
+#ifdef EUNOMIA_BLENDCHECK_AVX2
+  std::cout << "row kernels: AVX2 + SSE2" << std::endl;
+#else
+  std::cout << "row kernels: SSE2 (if available)" << std::endl;
+#endif
+
+  auto pairs = makePairs();
+
+  eunomia::NormalBrendCopier normal;
+  checkRows<RgbaColour, RgbColour>("Normal RGBA->RGB", normal, pairs, false);
+  checkRows<RgbColour, RgbaColour>("Normal RGB->RGBA", normal, pairs, false);
+
+  eunomia::AddBrendCopier add;
+  checkRows<RgbColour, RgbColour>("Add RGB->RGB", add, pairs, false);
+  checkRows<RgbaColour, RgbColour>("Add RGBA->RGB", add, pairs, false);
+  checkRows<RgbColour, RgbaColour>("Add RGB->RGBA", add, pairs, false);
+  checkRows<RgbaColour, RgbaColour>("Add RGBA->RGBA", add, pairs, false);
+
+  eunomia::MulBrendCopier mul;
+  checkRows<RgbColour, RgbColour>("Mul RGB->RGB", mul, pairs, false);
+  checkRows<RgbaColour, RgbColour>("Mul RGBA->RGB", mul, pairs, false);
+  checkRows<RgbColour, RgbaColour>("Mul RGB->RGBA", mul, pairs, false);
+  checkRows<RgbaColour, RgbaColour>("Mul RGBA->RGBA", mul, pairs, false);
+
+  eunomia::AlphaBrendCopier alpha;
+  checkRows<RgbaColour, RgbColour>("Alpha RGBA->RGB", alpha, pairs, false);
+  checkRows<RgbaColour, RgbaColour>("Alpha RGBA->RGBA", alpha, pairs, false);
+
+  checkIndexed<RgbColour>("Indexed ->RGB", pairs);
+  checkIndexed<RgbaColour>("Indexed ->RGBA", pairs);
+
+  eunomia::PremulBrendCopier premul;
+  checkRows<RgbaPremulColour, RgbColour>(
+    "Premul Premul->RGB", premul, pairs, true);
+  checkRows<RgbaPremulColour, RgbaPremulColour>(
+    "Premul Premul->Premul", premul, pairs, true);
+
+  using eunomia::CompositeOp;
+  checkComposite<CompositeOp::Src>("Composite Src", pairs);
+  checkComposite<CompositeOp::Over>("Composite Over", pairs);
+  checkComposite<CompositeOp::DstOver>("Composite DstOver", pairs);
+  checkComposite<CompositeOp::In>("Composite In", pairs);
+  checkComposite<CompositeOp::Out>("Composite Out", pairs);
+  checkComposite<CompositeOp::Atop>("Composite Atop", pairs);
+  checkComposite<CompositeOp::Xor>("Composite Xor", pairs);
+  checkComposite<CompositeOp::Screen>("Composite Screen", pairs);
+  checkComposite<CompositeOp::Overlay>("Composite Overlay", pairs);
+  checkComposite<CompositeOp::Darken>("Composite Darken", pairs);
+  checkComposite<CompositeOp::Lighten>("Composite Lighten", pairs);
+
+  checkStraight();
+
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+//eof
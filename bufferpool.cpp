@@ -0,0 +1,377 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file bufferpool.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの記憶領域を再利用するプール
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <bit>
+#include <new>
+#include "bufferpool.h"
+
+
+/*============================================
+ *  スレッド局所キャッシュと生存中のプールの登録簿
+ *==========================================*/
+namespace
+{
+
+/// 生存中のプールの登録簿
+struct Registry_
+{
+  std::mutex mutex;
+  std::unordered_map<const eunomia::BufferPool*, std::uint64_t> pools;
+  std::uint64_t next = 1;
+};
+
+Registry_& registry_() noexcept
+{
+  // スレッド終了時の局所キャッシュの後始末から參照されるため、
+  // 解體されないやうにしておく
+  static Registry_* r = new Registry_;
+  return *r;
+}
+
+}// end of NONAME namespace
+
+
+namespace eunomia
+{
+namespace implement_
+{
+
+/**
+ * @brief BufferPoolのスレッド局所キャッシュ
+ *
+ * 全てのプールの領域を一つの配列に保持する。
+ * スレッドの終了時には、殘つた領域を生存中のプールの共有キャッシュに返し、
+ * プールが既に解體されてゐれば解放する。
+ */
+class LocalBufferCache_
+{
+private:
+  struct Entry_
+  {
+    BufferPool* pool;
+    std::uint64_t serial;
+    std::size_t bytes;
+    std::uint8_t* p;
+  };
+
+  std::vector<Entry_> entries_;
+
+public:
+  LocalBufferCache_() = default;
+  ~LocalBufferCache_();
+
+  std::uint8_t* take(
+    const BufferPool* pool, std::uint64_t serial, std::size_t bytes) noexcept;
+
+  bool put(
+    BufferPool* pool, std::uint64_t serial, int capacity,
+    std::uint8_t* p, std::size_t bytes) noexcept;
+
+  void clear(BufferPool* pool, std::uint64_t serial) noexcept;
+};
+
+
+}// end of namespace implement_
+}// end of namespace eunomia
+
+
+namespace
+{
+
+thread_local eunomia::implement_::LocalBufferCache_ localCache_;
+
+}// end of NONAME namespace
+
+
+eunomia::implement_::LocalBufferCache_::~LocalBufferCache_()
+{
+  auto& reg = registry_();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  for (auto& e : entries_) {
+    auto it = reg.pools.find(e.pool);
+    if (it != reg.pools.end() && it->second == e.serial)
+      e.pool->putShared_(e.p, e.bytes);
+    else
+      BufferPool::freeBlock_(e.p);
+  }
+}
+
+
+std::uint8_t*
+eunomia::implement_::LocalBufferCache_::take(
+  const eunomia::BufferPool* pool, std::uint64_t serial, std::size_t bytes)
+noexcept
+{
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->pool == pool && it->serial == serial && it->bytes == bytes) {
+      auto p = it->p;
+      *it = entries_.back();
+      entries_.pop_back();
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+
+bool
+eunomia::implement_::LocalBufferCache_::put(
+  eunomia::BufferPool* pool, std::uint64_t serial, int capacity,
+  std::uint8_t* p, std::size_t bytes) noexcept
+{
+  int n = 0;
+  for (const auto& e : entries_)
+    if (e.pool == pool && e.serial == serial)
+      ++n;
+  if (n >= capacity)
+    return false;
+
+  try {
+    entries_.push_back(Entry_{pool, serial, bytes, p});
+  }
+  catch (std::bad_alloc&) {
+    return false;
+  }
+  return true;
+}
+
+
+void
+eunomia::implement_::LocalBufferCache_::clear(
+  eunomia::BufferPool* pool, std::uint64_t serial) noexcept
+{
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    auto& e = entries_[i];
+    if (e.pool == pool && e.serial == serial) {
+      pool->release_(e.bytes);
+      BufferPool::freeBlock_(e.p);
+    }
+    else
+      entries_[j++] = e;
+  }
+  entries_.resize(j);
+}
+
+
+
+
+/*============================================
+ *  BufferPool
+ *==========================================*/
+eunomia::BufferPool::BufferPool(std::size_t limit, int localCapacity)
+  : localCapacity_(localCapacity), retainLimit_(limit),
+    retained_(0), peakRetained_(0), allocations_(0),
+    localHits_(0), sharedHits_(0), misses_(0),
+    deallocations_(0), discards_(0)
+{
+  auto& reg = registry_();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  serial_ = reg.next++;
+  reg.pools[this] = serial_;
+}
+
+
+eunomia::BufferPool::~BufferPool()
+{
+  {
+    auto& reg = registry_();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.pools.erase(this);
+  }
+
+  localCache_.clear(this, serial_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [bytes, blocks] : shared_)
+    for (auto p : blocks)
+      freeBlock_(p);
+}
+
+
+std::size_t eunomia::BufferPool::classSize(std::size_t size) noexcept
+{
+  if (size <= MIN_CLASS_SIZE)
+    return MIN_CLASS_SIZE;
+
+  // 2^k < size <= 2^(k+1) のとき、2^k / 4 の倍數に切り上げる
+  int k = std::bit_width(size - 1) - 1;
+  std::size_t step = (std::size_t)1 << (k - 2);
+  std::size_t mask = step - 1;
+  if (size > SIZE_MAX - mask)
+    return size;
+  return (size + mask) & ~mask;
+}
+
+
+std::uint8_t* eunomia::BufferPool::allocate(std::size_t size)
+{
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  auto bytes = classSize(size);
+
+  if (auto p = localCache_.take(this, serial_, bytes)) {
+    release_(bytes);
+    localHits_.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = shared_.find(bytes);
+    if (it != shared_.end() && !it->second.empty()) {
+      auto p = it->second.back();
+      it->second.pop_back();
+      release_(bytes);
+      sharedHits_.fetch_add(1, std::memory_order_relaxed);
+      return p;
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  void* p;
+  try {
+    p = ::operator new[](bytes, std::align_val_t(BUFFER_ALIGNMENT));
+  }
+  catch (std::bad_alloc&) {
+    // 保持してゐる領域を手放してから再試行する
+    trim();
+    p = ::operator new[](bytes, std::align_val_t(BUFFER_ALIGNMENT));
+  }
+  return static_cast<std::uint8_t*>(p);
+}
+
+
+void
+eunomia::BufferPool::deallocate(std::uint8_t* p, std::size_t size) noexcept
+{
+  if (!p)
+    return;
+
+  deallocations_.fetch_add(1, std::memory_order_relaxed);
+  auto bytes = classSize(size);
+
+  if (!retain_(bytes)) {
+    discards_.fetch_add(1, std::memory_order_relaxed);
+    freeBlock_(p);
+    return;
+  }
+
+  if (localCache_.put(this, serial_, localCapacity_, p, bytes))
+    return;
+
+  putShared_(p, bytes);
+}
+
+
+void eunomia::BufferPool::trim() noexcept
+{
+  localCache_.clear(this, serial_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [bytes, blocks] : shared_) {
+    for (auto p : blocks) {
+      release_(bytes);
+      freeBlock_(p);
+    }
+  }
+  shared_.clear();
+}
+
+
+eunomia::BufferPoolStatistics
+eunomia::BufferPool::statistics() const noexcept
+{
+  BufferPoolStatistics st;
+  st.allocations = allocations_.load(std::memory_order_relaxed);
+  st.localHits = localHits_.load(std::memory_order_relaxed);
+  st.sharedHits = sharedHits_.load(std::memory_order_relaxed);
+  st.misses = misses_.load(std::memory_order_relaxed);
+  st.deallocations = deallocations_.load(std::memory_order_relaxed);
+  st.discards = discards_.load(std::memory_order_relaxed);
+  st.retainedBytes = retained_.load(std::memory_order_relaxed);
+  st.peakRetainedBytes = peakRetained_.load(std::memory_order_relaxed);
+  return st;
+}
+
+
+/// 保持バイト數にbytesを加へる。上限を超える場合は加へずにfalseを返す。
+bool eunomia::BufferPool::retain_(std::size_t bytes) noexcept
+{
+  auto limit = retainLimit();
+  auto cur = retained_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  if (cur > limit) {
+    retained_.fetch_sub(bytes, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto peak = peakRetained_.load(std::memory_order_relaxed);
+  while (cur > peak
+         && !peakRetained_.compare_exchange_weak(
+               peak, cur, std::memory_order_relaxed))
+    ;
+  return true;
+}
+
+
+void eunomia::BufferPool::release_(std::size_t bytes) noexcept
+{
+  retained_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+
+/// 共有キャッシュに領域を加へる。保持バイト數は計上濟みであること。
+void eunomia::BufferPool::putShared_(std::uint8_t* p, std::size_t bytes) noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  try {
+    shared_[bytes].push_back(p);
+  }
+  catch (std::bad_alloc&) {
+    release_(bytes);
+    discards_.fetch_add(1, std::memory_order_relaxed);
+    freeBlock_(p);
+  }
+}
+
+
+void eunomia::BufferPool::freeBlock_(std::uint8_t* p) noexcept
+{
+  ::operator delete[](p, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
+
+
+
+//eof
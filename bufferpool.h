@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file bufferpool.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの記憶領域を再利用するプール
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_BUFFER_POOL_H
+#define INCLUDE_GUARD_EUNOMIA_BUFFER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "noncopyable.h"
+#include "pixelbuffer.h"
+
+
+namespace eunomia
+{
+
+namespace implement_
+{
+class LocalBufferCache_;
+}
+
+
+/**
+ * @brief BufferPoolの統計情報
+ */
+struct BufferPoolStatistics
+{
+  std::size_t allocations;  ///< allocate()の呼び出し囘數
+  std::size_t localHits;  ///< スレッド局所キャッシュから供給した囘數
+  std::size_t sharedHits;  ///< 共有キャッシュから供給した囘數
+  std::size_t misses;  ///< 新たに領域を確保した囘數
+  std::size_t deallocations;  ///< deallocate()の呼び出し囘數
+  std::size_t discards;  ///< 保持上限を超えたため解放した囘數
+  std::size_t retainedBytes;  ///< 現在保持してゐるバイト數
+  std::size_t peakRetainedBytes;  ///< 保持バイト數の最大値
+};
+
+
+/**
+ * @brief 畫像バッファの記憶領域を再利用するプール
+ *
+ * 要求されたバイト數をサイズクラスに切り上げて確保し、
+ * 解放された領域をサイズクラス毎に保持して次の確保に再利用する。
+ * サイズクラスは2の冪の間を4等分した刻みで、無駄は高々25%である。
+ *
+ * 解放された領域は、まづ解放したスレッドの局所キャッシュに、
+ * それが一杯ならば全スレッドで共有するキャッシュに保持する。
+ * 保持する領域の總バイト數は保持上限を超えない。
+ * 上限を超える分は直ちに解放する。
+ *
+ * setDefaultBufferAllocator()に與へることで、
+ * Picture::create()やclone()の確保がこのプールを經由するやうになる。
+ * プールは、それを用ゐて確保された全ての畫像バッファよりも
+ * 長く生存してゐなければならない。
+ */
+class BufferPool : public BufferAllocator, Noncopyable<BufferPool>
+{
+public:
+  /// @brief 保持上限の既定値(バイト數)
+  static constexpr std::size_t DEFAULT_RETAIN_LIMIT = 256u << 20;
+  /// @brief スレッド局所キャッシュの容量の既定値(領域の個數)
+  static constexpr int DEFAULT_LOCAL_CAPACITY = 4;
+  /// @brief 最小のサイズクラス(バイト數)
+  static constexpr std::size_t MIN_CLASS_SIZE = 4096;
+
+private:
+  std::uint64_t serial_;  ///< プールの識別番號
+  int localCapacity_;  ///< スレッド毎の局所キャッシュの容量
+  std::atomic<std::size_t> retainLimit_;  ///< 保持上限
+
+  mutable std::mutex mutex_;  ///< 共有キャッシュの排他用
+  /// 共有キャッシュ(サイズクラス毎の空き領域)
+  std::unordered_map<std::size_t, std::vector<std::uint8_t*>> shared_;
+
+  std::atomic<std::size_t> retained_;
+  std::atomic<std::size_t> peakRetained_;
+  std::atomic<std::size_t> allocations_;
+  std::atomic<std::size_t> localHits_;
+  std::atomic<std::size_t> sharedHits_;
+  std::atomic<std::size_t> misses_;
+  std::atomic<std::size_t> deallocations_;
+  std::atomic<std::size_t> discards_;
+
+public:
+  /// @brief 構築子
+  /// @param limit 保持上限(バイト數)
+  /// @param localCapacity スレッド毎の局所キャッシュの容量(領域の個數)
+  explicit
+  BufferPool(
+    std::size_t limit = DEFAULT_RETAIN_LIMIT,
+    int localCapacity = DEFAULT_LOCAL_CAPACITY);
+
+  /// @brief 解體子
+  ///
+  /// 共有キャッシュの領域を解放する。
+  /// 各スレッドの局所キャッシュに殘つた領域は、
+  /// そのスレッドの終了時に解放される。
+  ~BufferPool();
+
+  std::uint8_t* allocate(std::size_t size) override;
+  void deallocate(std::uint8_t* p, std::size_t size) noexcept override;
+
+  /// @brief 保持上限の設定
+  ///
+  /// 既に保持してゐる領域は、次のtrim()まで解放されない。
+  void setRetainLimit(std::size_t limit) noexcept
+  {
+    retainLimit_.store(limit, std::memory_order_relaxed);
+  }
+
+  /// @brief 保持上限の取得
+  std::size_t retainLimit() const noexcept
+  {
+    return retainLimit_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief 共有キャッシュと呼び出したスレッドの局所キャッシュの領域を解放する
+  void trim() noexcept;
+
+  /// @brief 統計情報の取得
+  BufferPoolStatistics statistics() const noexcept;
+
+  /// @brief サイズクラスの算出
+  ///
+  /// sizeバイトの要求に對して實際に確保するバイト數を返す。
+  static std::size_t classSize(std::size_t size) noexcept;
+
+private:
+  bool retain_(std::size_t bytes) noexcept;
+  void release_(std::size_t bytes) noexcept;
+  void putShared_(std::uint8_t* p, std::size_t bytes) noexcept;
+
+  static void freeBlock_(std::uint8_t* p) noexcept;
+
+  friend class implement_::LocalBufferCache_;
+};
+
+
+}// end of namespace eunomia
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_BUFFER_POOL_H
+
+
+
+//eof
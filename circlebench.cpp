@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file circlebench.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 塗り潰した圓の描畫の計測用のプログラム
+ *
+ * 1フレームに多數の圓を描く處理を繰り返し、1フレームあたりの時間を表示する。
+ * 單色の塗り潰し(ellipse())とアルファブレンディング(fillCircle())を計る。
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include "picture.h"
+#include "picture_rgba.h"
+
+
+namespace {
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 720;
+
+constexpr int CIRCLES = 4000;  // 1フレームあたりの圓の數
+constexpr int MAX_R = 24;      // 半徑の最大値
+constexpr int FRAMES = 100;    // 計測するフレーム數
+
+
+/// 圓
+struct Circle
+{
+  int x;
+  int y;
+  int r;
+  eunomia::RgbaColour color;
+};
+
+
+/// 畫面から少しはみ出す範圍に圓を配置する
+std::vector<Circle> makeCircles()
+{
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> dx(-MAX_R, WIDTH + MAX_R);
+  std::uniform_int_distribution<int> dy(-MAX_R, HEIGHT + MAX_R);
+  std::uniform_int_distribution<int> dr(1, MAX_R);
+  std::uniform_int_distribution<int> dc(0, 255);
+
+  std::vector<Circle> circles(CIRCLES);
+  for (auto& c : circles) {
+    c.x = dx(rng);
+    c.y = dy(rng);
+    c.r = dr(rng);
+    c.color = eunomia::RgbaColour(dc(rng), dc(rng), dc(rng), dc(rng));
+  }
+  return circles;
+}
+
+
+/// func()をFRAMES囘實行し、1フレームあたりのミリ秒數を返す
+template<class Func>
+double measure(Func func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAMES; ++i)
+    func();
+  std::chrono::duration<double, std::milli> d
+    = std::chrono::steady_clock::now() - start;
+  return d.count() / FRAMES;
+}
+
+
+}//end of namespace
+
+
+int main()
+{
+  auto circles = makeCircles();
+  auto pict = eunomia::Picture::create(WIDTH, HEIGHT);
+
+  // 單色の塗り潰し
+  double solid = measure([&] {
+    pict->clear(eunomia::RgbColour(0, 0, 0));
+    for (const auto& c : circles) {
+      eunomia::RgbColour col(c.color.red, c.color.green, c.color.blue);
+      pict->circle(c.x, c.y, c.r, col, true);
+    }
+  });
+
+  // アルファブレンディングによる塗り潰し
+  double blend = measure([&] {
+    pict->clear(eunomia::RgbColour(0, 0, 0));
+    for (const auto& c : circles)
+      pict->fillCircle(c.x, c.y, c.r, c.color, eunomia::AlphaBrendCopier());
+  });
+
+  std::cout << CIRCLES << " circles/frame, " << WIDTH << "x" << HEIGHT
+            << std::endl;
+  std::cout << "solid fill: " << solid << " ms/frame" << std::endl;
+  std::cout << "blend fill: " << blend << " ms/frame" << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+
+//eof
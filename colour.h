@@ -38,6 +38,13 @@
  *    - RgbColour と RgbaColour との等價比較演算、非等價比較演算の追加
  *    - ImageBuffer<> で用ゐるための函數オブジェクトクラスの追加
  *
+ *  @date 2026.10.17
+ *    - AddBrendCopierが青要素を書き込んでゐなかつた誤りを修正
+ *    - 各ブレンド用函數オブジェクトに1ライン單位の轉送を追加
+ *    - NormalBrendCopierに同一畫素型間の轉送を追加
+ *    - 乘算濟みアルファのRGBA32bit色情報クラスとそのαブレンドを追加
+ *    - 乘算濟みアルファの合成演算子とその函數オブジェクトを追加
+ *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_COLOUR_H
 #define INCLUDE_GUARD_EUNOMIA_COLOUR_H
@@ -161,6 +168,99 @@ bool operator!=(const RgbColour& x, const RgbaColour& y) noexcept
 
 
 
+namespace implement_
+{
+/// @brief x * y / 255 を四捨五入して求める (0 <= x, y <= 255)
+constexpr
+inline
+std::uint8_t mulDiv255_(int x, int y) noexcept
+{
+  int t = x * y + 128;
+  return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+}
+}// end of namespace implement_
+
+
+/**
+ * @brief 乘算濟みアルファのRGBA32bit色情報クラス
+ *
+ * 各色要素には、本來の色要素にアルファ値を乘じて255で除した値を保持する。
+ * 從つて各色要素はアルファ値以下でなければならない。
+ * αブレンドは一要素あたり乘算一回で行へ、
+ * 擴大縮小でも透明な畫素の色が周圍に滲み出さない。
+ */
+class RgbaPremulColour
+{
+public:
+  std::uint8_t red;   ///< 赤要素(乘算濟み)
+  std::uint8_t green; ///< 緑要素(乘算濟み)
+  std::uint8_t blue;  ///< 青要素(乘算濟み)
+  std::uint8_t alpha; ///< アルファ値(不透過度)
+
+public:
+  /// @brief 構築子
+  ///
+  /// RGBA(0, 0, 0, 255)で初期化する。
+  constexpr
+  RgbaPremulColour() noexcept : red(0), green(0), blue(0), alpha(255) {}
+
+  /// @brief 構築子
+  ///
+  /// 乘算濟みのRGBA値を指定して初期化する。
+  constexpr
+  RgbaPremulColour(
+    std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) noexcept
+    : red(r), green(g), blue(b), alpha(a)
+    {}
+
+  /// @brief 構築子
+  ///
+  /// 乘算濟みでないRGBA値から變換する。
+  explicit constexpr RgbaPremulColour(const RgbaColour& c) noexcept
+    : red(implement_::mulDiv255_(c.red, c.alpha)),
+      green(implement_::mulDiv255_(c.green, c.alpha)),
+      blue(implement_::mulDiv255_(c.blue, c.alpha)),
+      alpha(c.alpha)
+    {}
+
+  /// @brief 構築子
+  explicit constexpr RgbaPremulColour(const RgbColour& rgb) noexcept
+    : red(rgb.red), green(rgb.green), blue(rgb.blue), alpha(255)
+    {}
+
+  /// @brief 變換
+  ///
+  /// 乘算濟みでないRGBA値に變換する。
+  /// アルファ値が0の場合はRGBA(0, 0, 0, 0)となる。
+  explicit constexpr operator RgbaColour() const noexcept
+  {
+    if (alpha == 0)
+      return RgbaColour(0, 0, 0, 0);
+    return RgbaColour(unmul_(red), unmul_(green), unmul_(blue), alpha);
+  }
+
+  /// @brief 等價比較演算子
+  constexpr
+  bool operator==(const RgbaPremulColour& other) const noexcept
+  {
+    return
+      red == other.red && green == other.green
+      && blue == other.blue && alpha == other.alpha;
+  }
+
+  /// @brief 非等價比較演算子
+  constexpr
+  bool operator!=(const RgbaPremulColour& other) const noexcept
+    { return !(*this == other); }
+
+private:
+  constexpr std::uint8_t unmul_(std::uint8_t c) const noexcept
+    { return std::min((c * 255 + alpha / 2) / alpha, 255); }
+};
+
+
+
+
 //// ImageBuffer<>::bltで用ゐる轉寫用の函數オブジェクト ////////
 
 /**
@@ -169,6 +269,22 @@ bool operator!=(const RgbColour& x, const RgbaColour& y) noexcept
 class NormalBrendCopier
 {
 public:
+  /// @brief 同一畫素型間の轉送が單純な複寫であることを示すタグ
+  ///
+  /// ImageBuffer<>::blt()はRgbColour同士、RgbaColour同士の轉送を
+  /// 函數呼び出しを經ずにmemmove()で行ふ。
+  using PlainCopyTag = void;
+
+  void operator()(const RgbColour& src, RgbColour& dst) noexcept
+  {
+    dst = src;
+  }
+
+  void operator()(const RgbaColour& src, RgbaColour& dst) noexcept
+  {
+    dst = src;
+  }
+
   void operator()(const RgbaColour& src, RgbColour& dst) noexcept
   {
     dst.red = src.red;
@@ -183,6 +299,14 @@ public:
     dst.blue = src.blue;
     // dst.alphaは變更しない
   }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void operator()(const RgbaColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbColour* src, RgbaColour* dst, int n) const noexcept;
 };
 
 
@@ -197,21 +321,21 @@ public:
   {
     dst.red = std::clamp(dst.red + src.red, 0, 255);
     dst.green = std::clamp(dst.green + src.green, 0, 255);
-    dst.red = std::clamp(dst.blue + src.blue, 0, 255);
+    dst.blue = std::clamp(dst.blue + src.blue, 0, 255);
   }
 
   void operator()(const RgbaColour& src, RgbColour& dst) noexcept
   {
     dst.red = std::clamp(dst.red + src.red, 0, 255);
     dst.green = std::clamp(dst.green + src.green, 0, 255);
-    dst.red = std::clamp(dst.blue + src.blue, 0, 255);
+    dst.blue = std::clamp(dst.blue + src.blue, 0, 255);
   }
 
   void operator()(const RgbColour& src, RgbaColour& dst) noexcept
   {
     dst.red = std::clamp(dst.red + src.red, 0, 255);
     dst.green = std::clamp(dst.green + src.green, 0, 255);
-    dst.red = std::clamp(dst.blue + src.blue, 0, 255);
+    dst.blue = std::clamp(dst.blue + src.blue, 0, 255);
     // dst.alphaは變更しない
   }
 
@@ -219,9 +343,19 @@ public:
   {
     dst.red = std::clamp(dst.red + src.red, 0, 255);
     dst.green = std::clamp(dst.green + src.green, 0, 255);
-    dst.red = std::clamp(dst.blue + src.blue, 0, 255);
+    dst.blue = std::clamp(dst.blue + src.blue, 0, 255);
     // dst.alphaは變更しない
   }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void operator()(const RgbColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbaColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbColour* src, RgbaColour* dst, int n) const noexcept;
+  void operator()(const RgbaColour* src, RgbaColour* dst, int n) const noexcept;
 };
 
 
@@ -261,6 +395,16 @@ public:
     dst.blue = std::clamp(dst.blue * src.blue / 255, 0, 255);
     // dst.alphaは變更しない
   }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void operator()(const RgbColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbaColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbColour* src, RgbaColour* dst, int n) const noexcept;
+  void operator()(const RgbaColour* src, RgbaColour* dst, int n) const noexcept;
 };
 
 
@@ -306,9 +450,202 @@ public:
           src.alpha + dst.alpha * (255 - src.alpha) / 255,
           0, 255);
   }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void operator()(const RgbaColour* src, RgbColour* dst, int n) const noexcept;
+  void operator()(const RgbaColour* src, RgbaColour* dst, int n) const noexcept;
 };
 
 
+/**
+ * @brief
+ *   ImageBuffer<>::blt()で用ゐる乘算濟みアルファのαブレンドのための
+ *   函數オブジェクトクラス
+ *
+ * 轉送元の乘算濟みの各要素sと轉送先の各要素dについて、
+ * s + d * (255 - a) / 255 (四捨五入)を求める。aは轉送元のアルファ値。
+ * 轉送先がRgbColourの場合は不透明な畫素として扱ふ。
+ */
+class PremulBrendCopier
+{
+public:
+  void operator()(const RgbaPremulColour& src, RgbColour& dst) noexcept
+  {
+    int t = 255 - src.alpha;
+    dst.red = over_(src.red, dst.red, t);
+    dst.green = over_(src.green, dst.green, t);
+    dst.blue = over_(src.blue, dst.blue, t);
+  }
+
+  void operator()(const RgbaPremulColour& src, RgbaPremulColour& dst) noexcept
+  {
+    int t = 255 - src.alpha;
+    dst.red = over_(src.red, dst.red, t);
+    dst.green = over_(src.green, dst.green, t);
+    dst.blue = over_(src.blue, dst.blue, t);
+    dst.alpha = over_(src.alpha, dst.alpha, t);
+  }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void
+  operator()(const RgbaPremulColour* src, RgbColour* dst, int n)
+    const noexcept;
+  void
+  operator()(const RgbaPremulColour* src, RgbaPremulColour* dst, int n)
+    const noexcept;
+
+private:
+  // 乘算濟みの値が正しければ255を超えることはないが、念のため飽和させる
+  static std::uint8_t over_(int s, int d, int t) noexcept
+    { return std::min(s + implement_::mulDiv255_(d, t), 255); }
+};
+
+
+/**
+ * @brief 合成演算子
+ *
+ * CompositeCopierで用ゐる。Sは轉送元、Dは轉送先、
+ * c、aはそれぞれ乘算濟みの色要素とアルファ値を表し、1を255とする。
+ * アルファ値は色要素と同じ式で求まる。
+ */
+enum class CompositeOp
+{
+  Src,      ///< S
+  Over,     ///< Sc + Dc(1 - Sa)
+  DstOver,  ///< Dc + Sc(1 - Da)
+  In,       ///< Sc Da
+  Out,      ///< Sc(1 - Da)
+  Atop,     ///< Sc Da + Dc(1 - Sa)
+  Xor,      ///< Sc(1 - Da) + Dc(1 - Sa)
+  Screen,   ///< Sc + Dc - Sc Dc
+  Overlay,  ///< 轉送先の明暗に應じて乘算かスクリーン
+  Darken,   ///< Sc + Dc - max(Sc Da, Dc Sa)
+  Lighten,  ///< Sc + Dc - min(Sc Da, Dc Sa)
+};
+
+
+namespace implement_
+{
+/// @brief x / 255 を四捨五入して求める (0 <= x <= 65025)
+constexpr
+inline
+int div255Round_(int x) noexcept
+{
+  int t = x + 128;
+  return (t + (t >> 8)) >> 8;
+}
+
+
+/// @brief 合成演算子OPによる一要素の合成
+///
+/// sa、daはアルファ値、s、dは乘算濟みの要素(アルファ値を含む)。
+/// 各項を255倍した整數で計算してから一度だけ255で除して四捨五入する。
+/// 乘算濟みの値が正しければ、除する前の値は0以上65025以下に收まる。
+template<CompositeOp OP>
+constexpr
+inline
+std::uint8_t composite_(int s, int d, int sa, int da) noexcept
+{
+  int x;
+  if constexpr (OP == CompositeOp::Src)
+    return static_cast<std::uint8_t>(s);
+  else if constexpr (OP == CompositeOp::Over)
+    x = 255 * s + d * (255 - sa);
+  else if constexpr (OP == CompositeOp::DstOver)
+    x = 255 * d + s * (255 - da);
+  else if constexpr (OP == CompositeOp::In)
+    x = s * da;
+  else if constexpr (OP == CompositeOp::Out)
+    x = s * (255 - da);
+  else if constexpr (OP == CompositeOp::Atop)
+    x = s * da + d * (255 - sa);
+  else if constexpr (OP == CompositeOp::Xor)
+    x = s * (255 - da) + d * (255 - sa);
+  else if constexpr (OP == CompositeOp::Screen)
+    x = 255 * (s + d) - s * d;
+  else if constexpr (OP == CompositeOp::Overlay)
+    x = s * (255 - da) + d * (255 - sa)
+        + (2 * d <= da ? 2 * s * d : sa * da - 2 * (da - d) * (sa - s));
+  else if constexpr (OP == CompositeOp::Darken)
+    x = 255 * (s + d) - std::max(s * da, d * sa);
+  else if constexpr (OP == CompositeOp::Lighten)
+    x = 255 * (s + d) - std::min(s * da, d * sa);
+
+  return static_cast<std::uint8_t>(std::clamp(div255Round_(x), 0, 255));
+}
+}// end of namespace implement_
+
+
+/**
+ * @brief
+ *   ImageBuffer<>::blt()で用ゐる乘算濟みアルファの合成のための
+ *   函數オブジェクトクラステンプレート
+ *
+ * 轉送元と轉送先の各要素を合成演算子OPで合成する。
+ * 255での除算は四捨五入で正確に行ふ。
+ * 轉送先がRgbColourの場合は不透明な畫素として扱ひ、
+ * 合成結果のアルファ値は捨てる。
+ * 轉送元、轉送先とも乘算濟みの値が正しいことを前提とする。
+ */
+template<CompositeOp OP>
+class CompositeCopier
+{
+public:
+  void operator()(const RgbaPremulColour& src, RgbColour& dst) const noexcept
+  {
+    int sa = src.alpha;
+    dst.red = implement_::composite_<OP>(src.red, dst.red, sa, 255);
+    dst.green = implement_::composite_<OP>(src.green, dst.green, sa, 255);
+    dst.blue = implement_::composite_<OP>(src.blue, dst.blue, sa, 255);
+  }
+
+  void
+  operator()(const RgbaPremulColour& src, RgbaPremulColour& dst)
+    const noexcept
+  {
+    int sa = src.alpha;
+    int da = dst.alpha;
+    dst.red = implement_::composite_<OP>(src.red, dst.red, sa, da);
+    dst.green = implement_::composite_<OP>(src.green, dst.green, sa, da);
+    dst.blue = implement_::composite_<OP>(src.blue, dst.blue, sa, da);
+    dst.alpha = implement_::composite_<OP>(sa, da, sa, da);
+  }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をdst[0]〜dst[n-1]に轉送する。
+  /// SSE2、AVX2が使へる場合はそれらを用ゐて處理する。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void
+  operator()(const RgbaPremulColour* src, RgbColour* dst, int n)
+    const noexcept;
+  void
+  operator()(const RgbaPremulColour* src, RgbaPremulColour* dst, int n)
+    const noexcept;
+};
+
+// 1ライン分の轉送はcolour_blend.cppで實體化する
+extern template class CompositeCopier<CompositeOp::Src>;
+extern template class CompositeCopier<CompositeOp::Over>;
+extern template class CompositeCopier<CompositeOp::DstOver>;
+extern template class CompositeCopier<CompositeOp::In>;
+extern template class CompositeCopier<CompositeOp::Out>;
+extern template class CompositeCopier<CompositeOp::Atop>;
+extern template class CompositeCopier<CompositeOp::Xor>;
+extern template class CompositeCopier<CompositeOp::Screen>;
+extern template class CompositeCopier<CompositeOp::Overlay>;
+extern template class CompositeCopier<CompositeOp::Darken>;
+extern template class CompositeCopier<CompositeOp::Lighten>;
+
+
 /// @brief ImageBuffer<>::blt()で用ゐるαブレンドのための函數オブジェクトクラス
 ///
 /// このクラスのオブジェクトをImageBuffer<>::blt()で用ゐるとき、
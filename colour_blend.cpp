@@ -0,0 +1,825 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file colour_blend.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ブレンド用函數オブジェクトの1ライン單位の轉送
+ *
+ * SSE2、AVX2が使へる場合はそれらを用ゐて複數の畫素を一度に處理する。
+ * 除算x / 255は (x * 0x8081) >> 23 で正確に求め、
+ * 一畫素づつ轉送した場合と全く同じ結果を得る。
+ *
+ * @date 2026.10.17 作成
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "colour.h"
+#include "picture_indexed.h"
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EUNOMIA_BLEND_SSE2_
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define EUNOMIA_BLEND_SSSE3_
+#include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define EUNOMIA_BLEND_AVX2_
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+using std::uint8_t;
+using eunomia::RgbColour;
+using eunomia::RgbaColour;
+using eunomia::RgbaPremulColour;
+
+static_assert(sizeof(RgbColour) == 3 && sizeof(RgbaColour) == 4);
+static_assert(sizeof(RgbaPremulColour) == 4);
+
+
+#ifdef EUNOMIA_BLEND_SSE2_
+constexpr bool HAS_SIMD_ = true;
+#else
+constexpr bool HAS_SIMD_ = false;
+#endif
+
+// RGB畫素をRGBA形式に展開して處理する際に、一度に扱ふ畫素數
+constexpr int CHUNK_ = 64;
+
+
+//// 命令セット毎の基本演算 ////////
+//
+// 4バイトで1畫素(R, G, B, A)の竝びを1本のレジスタに收め、
+// バイト單位の演算と、16bitに擴張した上での演算とを提供する。
+
+#ifdef EUNOMIA_BLEND_SSE2_
+struct Sse2_
+{
+  using V = __m128i;
+  static constexpr int PIXELS = 4;
+
+  static V load(const uint8_t* p) noexcept
+    { return _mm_loadu_si128(reinterpret_cast<const V*>(p)); }
+  static void store(uint8_t* p, V v) noexcept
+    { _mm_storeu_si128(reinterpret_cast<V*>(p), v); }
+
+  static V set16(std::uint16_t x) noexcept { return _mm_set1_epi16(x); }
+  static V set32(std::uint32_t x) noexcept { return _mm_set1_epi32(x); }
+  static V set64(std::uint64_t x) noexcept { return _mm_set1_epi64x(x); }
+
+  static V lo16(V x) noexcept
+    { return _mm_unpacklo_epi8(x, _mm_setzero_si128()); }
+  static V hi16(V x) noexcept
+    { return _mm_unpackhi_epi8(x, _mm_setzero_si128()); }
+  static V pack(V lo, V hi) noexcept { return _mm_packus_epi16(lo, hi); }
+
+  static V adds8(V a, V b) noexcept { return _mm_adds_epu8(a, b); }
+  static V add16(V a, V b) noexcept { return _mm_add_epi16(a, b); }
+  static V sub16(V a, V b) noexcept { return _mm_sub_epi16(a, b); }
+  static V mul16(V a, V b) noexcept { return _mm_mullo_epi16(a, b); }
+  static V subs16u(V a, V b) noexcept { return _mm_subs_epu16(a, b); }
+  static V cmpgt16(V a, V b) noexcept { return _mm_cmpgt_epi16(a, b); }
+
+  // 0 <= x <= 65535 の各要素について x / 255 (切り捨て)
+  static V div255(V x) noexcept
+    { return _mm_srli_epi16(_mm_mulhi_epu16(x, set16(0x8081)), 7); }
+
+  // 16bitに擴張した各畫素のアルファ値を、その畫素の全要素に行き渡らせる
+  static V alpha16(V x) noexcept
+    { return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF); }
+
+  // maskの立つたビットはbから、さもなくばaから取る
+  static V select(V mask, V a, V b) noexcept
+    { return _mm_or_si128(_mm_andnot_si128(mask, a), _mm_and_si128(mask, b)); }
+};
+#endif
+
+
+#ifdef EUNOMIA_BLEND_AVX2_
+struct Avx2_
+{
+  using V = __m256i;
+  static constexpr int PIXELS = 8;
+
+  static V load(const uint8_t* p) noexcept
+    { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+  static void store(uint8_t* p, V v) noexcept
+    { _mm256_storeu_si256(reinterpret_cast<V*>(p), v); }
+
+  static V set16(std::uint16_t x) noexcept { return _mm256_set1_epi16(x); }
+  static V set32(std::uint32_t x) noexcept { return _mm256_set1_epi32(x); }
+  static V set64(std::uint64_t x) noexcept { return _mm256_set1_epi64x(x); }
+
+  // unpack、packは128bit毎に行はれるが、互ひに逆の竝べ替へなので問題ない
+  static V lo16(V x) noexcept
+    { return _mm256_unpacklo_epi8(x, _mm256_setzero_si256()); }
+  static V hi16(V x) noexcept
+    { return _mm256_unpackhi_epi8(x, _mm256_setzero_si256()); }
+  static V pack(V lo, V hi) noexcept { return _mm256_packus_epi16(lo, hi); }
+
+  static V adds8(V a, V b) noexcept { return _mm256_adds_epu8(a, b); }
+  static V add16(V a, V b) noexcept { return _mm256_add_epi16(a, b); }
+  static V sub16(V a, V b) noexcept { return _mm256_sub_epi16(a, b); }
+  static V mul16(V a, V b) noexcept { return _mm256_mullo_epi16(a, b); }
+  static V subs16u(V a, V b) noexcept { return _mm256_subs_epu16(a, b); }
+  static V cmpgt16(V a, V b) noexcept { return _mm256_cmpgt_epi16(a, b); }
+
+  static V div255(V x) noexcept
+    { return _mm256_srli_epi16(_mm256_mulhi_epu16(x, set16(0x8081)), 7); }
+
+  static V alpha16(V x) noexcept
+  {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+  }
+
+  static V select(V mask, V a, V b) noexcept
+  {
+    return
+      _mm256_or_si256(_mm256_andnot_si256(mask, a), _mm256_and_si256(mask, b));
+  }
+};
+#endif
+
+
+// 4バイトの畫素のうちアルファ値のバイト
+constexpr std::uint32_t ALPHA_MASK_ = 0xFF000000u;
+// 16bitに擴張した畫素のうちアルファ値の要素
+constexpr std::uint64_t ALPHA_MASK16_ = 0xFFFF000000000000u;
+
+
+//// 4バイト/畫素の竝びに對する處理 ////////
+//
+// run<I>()は命令セットIのレジスタ1本分(I::PIXELS畫素)を處理する。
+// KEEP_ALPHAが眞の場合、dの畫素のアルファ値は變更しない。
+
+/*
+ * @brief 加算ブレンド
+ */
+template<bool KEEP_ALPHA>
+struct AddLanes_
+{
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vs = I::load(s);
+    auto vd = I::load(d);
+    auto r = I::adds8(vd, vs);
+    if constexpr (KEEP_ALPHA)
+      r = I::select(I::set32(ALPHA_MASK_), r, vd);
+    I::store(d, r);
+  }
+};
+
+
+/*
+ * @brief 乘算ブレンド
+ */
+template<bool KEEP_ALPHA>
+struct MulLanes_
+{
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vs = I::load(s);
+    auto vd = I::load(d);
+    auto lo = I::div255(I::mul16(I::lo16(vd), I::lo16(vs)));
+    auto hi = I::div255(I::mul16(I::hi16(vd), I::hi16(vs)));
+    auto r = I::pack(lo, hi);
+    if constexpr (KEEP_ALPHA)
+      r = I::select(I::set32(ALPHA_MASK_), r, vd);
+    I::store(d, r);
+  }
+};
+
+
+/*
+ * @brief αブレンド
+ *
+ * 各要素について s * a / 255 + d * (255 - a) / 255 を求める。
+ * アルファ値の要素はsの代はりに255を乘じ、a + d * (255 - a) / 255 となる。
+ */
+struct AlphaLanes_
+{
+  // 16bitに擴張した畫素同士のブレンド
+  template<class I>
+  static typename I::V blend16(typename I::V s, typename I::V d) noexcept
+  {
+    auto a = I::alpha16(s);
+    auto sa = I::select(I::set64(ALPHA_MASK16_), a, I::set16(255));
+    auto t1 = I::div255(I::mul16(s, sa));
+    auto t2 = I::div255(I::mul16(d, I::sub16(I::set16(255), a)));
+    return I::add16(t1, t2);
+  }
+
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vs = I::load(s);
+    auto vd = I::load(d);
+    auto lo = blend16<I>(I::lo16(vs), I::lo16(vd));
+    auto hi = blend16<I>(I::hi16(vs), I::hi16(vd));
+    I::store(d, I::pack(lo, hi));
+  }
+};
+
+
+/*
+ * @brief 乘算濟みアルファのαブレンド
+ *
+ * アルファ値を含む各要素について s + (d * (255 - a) + 127) / 255 を求める。
+ */
+struct PremulLanes_
+{
+  template<class I>
+  static typename I::V blend16(typename I::V s, typename I::V d) noexcept
+  {
+    auto t = I::sub16(I::set16(255), I::alpha16(s));
+    return I::add16(s, I::div255(I::add16(I::mul16(d, t), I::set16(127))));
+  }
+
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vs = I::load(s);
+    auto vd = I::load(d);
+    auto lo = blend16<I>(I::lo16(vs), I::lo16(vd));
+    auto hi = blend16<I>(I::hi16(vs), I::hi16(vd));
+    I::store(d, I::pack(lo, hi));
+  }
+};
+
+
+/*
+ * @brief 乘算濟みアルファの合成演算子による合成
+ *
+ * implement_::composite_<OP>()と同じ式を16bitの要素毎に計算する。
+ * 途中の値が16bitを溢れても、最終的な値は0以上65025以下に收まるので、
+ * 2^16を法とする演算で正しく求まる。
+ * (x + 127) / 255 は div255() で求める。
+ * DST_OPAQUEが眞の場合、dのアルファ値を255とみなす。
+ */
+template<eunomia::CompositeOp OP, bool DST_OPAQUE>
+struct CompositeLanes_
+{
+  using Op = eunomia::CompositeOp;
+
+  // 符號無し16bitの最大値と最小値
+  template<class I>
+  static typename I::V max16u(typename I::V a, typename I::V b) noexcept
+    { return I::add16(I::subs16u(a, b), b); }
+  template<class I>
+  static typename I::V min16u(typename I::V a, typename I::V b) noexcept
+    { return I::sub16(a, I::subs16u(a, b)); }
+
+  template<class I>
+  static typename I::V blend16(typename I::V s, typename I::V d) noexcept
+  {
+    if constexpr (OP == Op::Src)
+      return s;
+    else {
+      auto c255 = I::set16(255);
+      auto sa = I::alpha16(s);
+      auto da = DST_OPAQUE ? c255 : I::alpha16(d);
+      auto isa = I::sub16(c255, sa);
+      auto ida = I::sub16(c255, da);
+
+      typename I::V x;
+      if constexpr (OP == Op::Over)
+        x = I::add16(I::mul16(s, c255), I::mul16(d, isa));
+      else if constexpr (OP == Op::DstOver)
+        x = I::add16(I::mul16(d, c255), I::mul16(s, ida));
+      else if constexpr (OP == Op::In)
+        x = I::mul16(s, da);
+      else if constexpr (OP == Op::Out)
+        x = I::mul16(s, ida);
+      else if constexpr (OP == Op::Atop)
+        x = I::add16(I::mul16(s, da), I::mul16(d, isa));
+      else if constexpr (OP == Op::Xor)
+        x = I::add16(I::mul16(s, ida), I::mul16(d, isa));
+      else if constexpr (OP == Op::Screen)
+        x = I::sub16(I::mul16(I::add16(s, d), c255), I::mul16(s, d));
+      else if constexpr (OP == Op::Overlay) {
+        auto dark = I::mul16(I::add16(s, s), d);
+        auto dd = I::sub16(da, d);
+        auto light
+          = I::sub16(
+              I::mul16(sa, da), I::mul16(I::add16(dd, dd), I::sub16(sa, s)));
+        auto bright = I::cmpgt16(I::add16(d, d), da);
+        x = I::add16(
+              I::add16(I::mul16(s, ida), I::mul16(d, isa)),
+              I::select(bright, dark, light));
+      }
+      else if constexpr (OP == Op::Darken)
+        x = I::sub16(
+              I::mul16(I::add16(s, d), c255),
+              max16u<I>(I::mul16(s, da), I::mul16(d, sa)));
+      else if constexpr (OP == Op::Lighten)
+        x = I::sub16(
+              I::mul16(I::add16(s, d), c255),
+              min16u<I>(I::mul16(s, da), I::mul16(d, sa)));
+
+      return I::div255(I::add16(x, I::set16(127)));
+    }
+  }
+
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vs = I::load(s);
+    auto vd = I::load(d);
+    auto lo = blend16<I>(I::lo16(vs), I::lo16(vd));
+    auto hi = blend16<I>(I::hi16(vs), I::hi16(vd));
+    I::store(d, I::pack(lo, hi));
+  }
+};
+
+
+/*
+ * @brief 單純轉送(アルファ値は轉送先のものを殘す)
+ */
+struct NormalLanes_
+{
+  template<class I>
+  static void run(const uint8_t* s, uint8_t* d) noexcept
+  {
+    auto vd = I::load(d);
+    I::store(d, I::select(I::set32(ALPHA_MASK_), I::load(s), vd));
+  }
+};
+
+
+/*
+ * @brief 4バイト/畫素で竝んだm畫素を處理する
+ * @return 處理した畫素數
+ *
+ * 使へる最も幅の廣い命令セットで處理し、
+ * 半端な畫素は處理せずに殘す。
+ */
+template<class K>
+int runLanes_(
+  [[maybe_unused]] const uint8_t* s, [[maybe_unused]] uint8_t* d,
+  [[maybe_unused]] int m) noexcept
+{
+  int i = 0;
+#ifdef EUNOMIA_BLEND_AVX2_
+  for (; i + Avx2_::PIXELS <= m; i += Avx2_::PIXELS)
+    K::template run<Avx2_>(s + 4 * i, d + 4 * i);
+#endif
+#ifdef EUNOMIA_BLEND_SSE2_
+  for (; i + Sse2_::PIXELS <= m; i += Sse2_::PIXELS)
+    K::template run<Sse2_>(s + 4 * i, d + 4 * i);
+#endif
+  return i;
+}
+
+
+//// RGBとRGBAの竝べ替へ ////////
+
+/*
+ * @brief 64bit整數の讀み書き(リトルエンディアンを假定する)
+ */
+inline std::uint64_t load64_(const uint8_t* p) noexcept
+{
+  std::uint64_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+inline void store64_(uint8_t* p, std::uint64_t x) noexcept
+  { std::memcpy(p, &x, sizeof(x)); }
+
+
+/*
+ * @brief RGB畫素m個をRGBA形式に展開する
+ *
+ * 展開先のアルファ値は不定。
+ */
+[[maybe_unused]]
+void expand_(const uint8_t* s, uint8_t* d, int m) noexcept
+{
+  int i = 0;
+#if defined(EUNOMIA_BLEND_SSSE3_)
+  const __m128i sh
+    = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  // 16バイトを讀むので、(i + 6)畫素目まで存在する範圍で處理する
+  for (; i + 6 <= m; i += 4) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * i));
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(d + 4 * i), _mm_shuffle_epi8(v, sh));
+  }
+#elif defined(EUNOMIA_BLEND_SSE2_)
+  // 8バイトを讀むので、(i + 3)畫素目まで存在する範圍で2畫素づつ處理する
+  constexpr std::uint64_t RGB = 0xFFFFFF;
+  for (; i + 3 <= m; i += 2) {
+    auto x = load64_(s + 3 * i);
+    store64_(d + 4 * i, (x & RGB) | ((x << 8) & (RGB << 32)));
+  }
+#endif
+  for (; i < m; ++i) {
+    d[4 * i] = s[3 * i];
+    d[4 * i + 1] = s[3 * i + 1];
+    d[4 * i + 2] = s[3 * i + 2];
+    d[4 * i + 3] = 255;
+  }
+}
+
+
+/*
+ * @brief RGBA畫素m個をRGB形式に詰める
+ */
+void pack_(const uint8_t* s, uint8_t* d, int m) noexcept
+{
+  int i = 0;
+#if defined(EUNOMIA_BLEND_SSSE3_)
+  const __m128i sh
+    = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  // 16バイトを書くので、(i + 6)畫素目まで存在する範圍で處理する
+  // (餘分に書いた4バイトは次の反復で上書きされる)
+  for (; i + 6 <= m; i += 4) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * i));
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(d + 3 * i), _mm_shuffle_epi8(v, sh));
+  }
+#elif defined(EUNOMIA_BLEND_SSE2_)
+  // 8バイトを書くので、(i + 3)畫素目まで存在する範圍で2畫素づつ處理する
+  // (餘分に書いた2バイトは次の反復で上書きされる)
+  constexpr std::uint64_t RGB = 0xFFFFFF;
+  for (; i + 3 <= m; i += 2) {
+    auto x = load64_(s + 4 * i);
+    store64_(d + 3 * i, (x & RGB) | ((x >> 8) & (RGB << 24)));
+  }
+#endif
+  for (; i < m; ++i) {
+    d[3 * i] = s[4 * i];
+    d[3 * i + 1] = s[4 * i + 1];
+    d[3 * i + 2] = s[4 * i + 2];
+  }
+}
+
+
+/*
+ * @brief 1ライン分のブレンド
+ *
+ * RGB畫素はCHUNK_畫素づつRGBA形式に展開してKで處理し、
+ * 轉送先がRGBならば詰め直して書き戻す。
+ * Kで處理しきれなかつた半端な畫素は一畫素づつrefで處理する。
+ */
+template<class K, class CSrc, class CDst, class Ref>
+void blendRow_(const CSrc* src, CDst* dst, int n, Ref ref) noexcept
+{
+  if constexpr (!HAS_SIMD_) {
+    for (int i = 0; i < n; ++i)
+      ref(src[i], dst[i]);
+  }
+  else {
+    constexpr bool SRC_RGB = sizeof(CSrc) == 3;
+    constexpr bool DST_RGB = sizeof(CDst) == 3;
+    alignas(64) uint8_t sbuf[SRC_RGB ? CHUNK_ * 4 : 1];
+    alignas(64) uint8_t dbuf[DST_RGB ? CHUNK_ * 4 : 1];
+
+    for (int done = 0; done < n; done += CHUNK_) {
+      int m = std::min(CHUNK_, n - done);
+      auto s = reinterpret_cast<const uint8_t*>(src + done);
+      auto d = reinterpret_cast<uint8_t*>(dst + done);
+
+      const uint8_t* s4 = s;
+      uint8_t* d4 = d;
+      if constexpr (SRC_RGB) {
+        expand_(s, sbuf, m);
+        s4 = sbuf;
+      }
+      if constexpr (DST_RGB) {
+        expand_(d, dbuf, m);
+        d4 = dbuf;
+      }
+
+      int k = runLanes_<K>(s4, d4, m);
+
+      if constexpr (DST_RGB)
+        pack_(dbuf, d, k);
+      for (int i = k; i < m; ++i)
+        ref(src[done + i], dst[done + i]);
+    }
+  }
+}
+
+
+/*
+ * @brief RGB同士のバイト單位のブレンド
+ *
+ * 3n バイトをそのまま4バイト單位でKに渡し、半端なバイトはopで處理する。
+ */
+template<class K, class Op>
+void blendBytes_(const RgbColour* src, RgbColour* dst, int n, Op op) noexcept
+{
+  auto s = reinterpret_cast<const uint8_t*>(src);
+  auto d = reinterpret_cast<uint8_t*>(dst);
+  std::size_t nb = 3 * static_cast<std::size_t>(n);
+
+  auto k = 4 * static_cast<std::size_t>(runLanes_<K>(s, d, int(nb / 4)));
+  for (; k < nb; ++k)
+    d[k] = op(s[k], d[k]);
+}
+
+
+}// end of NONAME namespace
+
+
+
+
+//// NormalBrendCopier ////////
+
+void
+eunomia::NormalBrendCopier::operator()(
+  const RgbaColour* src, RgbColour* dst, int n) const noexcept
+{
+  pack_(
+    reinterpret_cast<const uint8_t*>(src), reinterpret_cast<uint8_t*>(dst), n);
+}
+
+
+void
+eunomia::NormalBrendCopier::operator()(
+  const RgbColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<NormalLanes_>(src, dst, n, *this);
+}
+
+
+
+
+//// AddBrendCopier ////////
+
+void
+eunomia::AddBrendCopier::operator()(
+  const RgbColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendBytes_<AddLanes_<false>>(
+    src, dst, n,
+    [](int s, int d) { return static_cast<uint8_t>(std::min(s + d, 255)); });
+}
+
+
+void
+eunomia::AddBrendCopier::operator()(
+  const RgbaColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendRow_<AddLanes_<false>>(src, dst, n, *this);
+}
+
+
+void
+eunomia::AddBrendCopier::operator()(
+  const RgbColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<AddLanes_<true>>(src, dst, n, *this);
+}
+
+
+void
+eunomia::AddBrendCopier::operator()(
+  const RgbaColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<AddLanes_<true>>(src, dst, n, *this);
+}
+
+
+
+
+//// MulBrendCopier ////////
+
+void
+eunomia::MulBrendCopier::operator()(
+  const RgbColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendBytes_<MulLanes_<false>>(
+    src, dst, n,
+    [](int s, int d) { return static_cast<uint8_t>(d * s / 255); });
+}
+
+
+void
+eunomia::MulBrendCopier::operator()(
+  const RgbaColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendRow_<MulLanes_<false>>(src, dst, n, *this);
+}
+
+
+void
+eunomia::MulBrendCopier::operator()(
+  const RgbColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<MulLanes_<true>>(src, dst, n, *this);
+}
+
+
+void
+eunomia::MulBrendCopier::operator()(
+  const RgbaColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<MulLanes_<true>>(src, dst, n, *this);
+}
+
+
+
+
+//// AlphaBrendCopier ////////
+
+void
+eunomia::AlphaBrendCopier::operator()(
+  const RgbaColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendRow_<AlphaLanes_>(src, dst, n, *this);
+}
+
+
+void
+eunomia::AlphaBrendCopier::operator()(
+  const RgbaColour* src, RgbaColour* dst, int n) const noexcept
+{
+  blendRow_<AlphaLanes_>(src, dst, n, *this);
+}
+
+
+
+
+//// PremulBrendCopier ////////
+
+void
+eunomia::PremulBrendCopier::operator()(
+  const RgbaPremulColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendRow_<PremulLanes_>(src, dst, n, *this);
+}
+
+
+void
+eunomia::PremulBrendCopier::operator()(
+  const RgbaPremulColour* src, RgbaPremulColour* dst, int n) const noexcept
+{
+  blendRow_<PremulLanes_>(src, dst, n, *this);
+}
+
+
+
+
+//// CompositeCopier ////////
+
+template<eunomia::CompositeOp OP>
+void
+eunomia::CompositeCopier<OP>::operator()(
+  const RgbaPremulColour* src, RgbColour* dst, int n) const noexcept
+{
+  blendRow_<CompositeLanes_<OP, true>>(src, dst, n, *this);
+}
+
+
+template<eunomia::CompositeOp OP>
+void
+eunomia::CompositeCopier<OP>::operator()(
+  const RgbaPremulColour* src, RgbaPremulColour* dst, int n) const noexcept
+{
+  blendRow_<CompositeLanes_<OP, false>>(src, dst, n, *this);
+}
+
+
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Src>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Over>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::DstOver>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::In>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Out>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Atop>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Xor>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Screen>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Overlay>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Darken>;
+template class eunomia::CompositeCopier<eunomia::CompositeOp::Lighten>;
+
+
+
+
+//// NormalBrendCopierFromPictureIndexed ////////
+
+namespace
+{
+
+/*
+ * @brief インデックスm個を表引きして4バイト/畫素の竝びを得る
+ */
+void lookup_(
+  const std::uint32_t* lut, const uint8_t* s, std::uint32_t* d, int m) noexcept
+{
+  int i = 0;
+#ifdef EUNOMIA_BLEND_AVX2_
+  for (; i + 8 <= m; i += 8) {
+    auto idx
+      = _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i)));
+    auto v
+      = _mm256_i32gather_epi32(reinterpret_cast<const int*>(lut), idx, 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), v);
+  }
+#endif
+  for (; i < m; ++i)
+    d[i] = lut[s[i]];
+}
+
+
+/*
+ * @brief 1ライン分のパレット展開
+ *
+ * CHUNK_畫素づつ表引きし、轉送先がRGBならば詰めて書き込み、
+ * RGBAならばアルファ値を殘して書き込む。
+ * 處理しきれなかつた半端な畫素は一畫素づつrefで處理する。
+ */
+template<class CDst, class Ref>
+void expandRow_(
+  const std::uint32_t* lut, const uint8_t* src, CDst* dst, int n, Ref& ref)
+  noexcept
+{
+  alignas(64) std::uint32_t buf[CHUNK_];
+
+  for (int done = 0; done < n; done += CHUNK_) {
+    int m = std::min(CHUNK_, n - done);
+    lookup_(lut, src + done, buf, m);
+
+    auto b = reinterpret_cast<const uint8_t*>(buf);
+    auto d = reinterpret_cast<uint8_t*>(dst + done);
+    if constexpr (sizeof(CDst) == 3)
+      pack_(b, d, m);
+    else {
+      int k = runLanes_<NormalLanes_>(b, d, m);
+      for (int i = k; i < m; ++i)
+        ref(src[done + i], dst[done + i]);
+    }
+  }
+}
+
+
+}// end of NONAME namespace
+
+
+eunomia::NormalBrendCopierFromPictureIndexed::
+NormalBrendCopierFromPictureIndexed(const PictureIndexed& p) noexcept
+{
+  for (int i = 0; i < 256; ++i) {
+    RgbaColour c(p.palette(i));
+    std::memcpy(&lut_[i], &c, sizeof(c));
+  }
+}
+
+
+void
+eunomia::NormalBrendCopierFromPictureIndexed::operator()(
+  const std::uint8_t* src, RgbColour* dst, int n) const noexcept
+{
+  expandRow_(lut_, src, dst, n, *this);
+}
+
+
+void
+eunomia::NormalBrendCopierFromPictureIndexed::operator()(
+  const std::uint8_t* src, RgbaColour* dst, int n) const noexcept
+{
+  expandRow_(lut_, src, dst, n, *this);
+}
+
+
+
+
+//eof
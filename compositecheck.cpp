@@ -0,0 +1,202 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file compositecheck.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief Compositorによる竝列合成の檢査用のプログラム
+ *
+ * 變更範圍を追跡してゐる畫像にCompositorで竝列に合成し、
+ * (1) 結果が命令を一つづつblt()した場合と一致すること、
+ * (2) 記録された變更範圍が實行毎に變はらないこと、
+ * (3) 變更された畫素が全て變更範圍に含まれること
+ * を確かめる。
+ * 全て滿たせば0を、さもなくば1を返す。
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+#include "compositor.h"
+#include "picture.h"
+#include "picture_rgba.h"
+
+
+namespace {
+
+constexpr int WIDTH = 640;
+constexpr int HEIGHT = 480;
+constexpr int SPRITES = 300;  // 轉送命令の數
+constexpr int RUNS = 20;      // 合成を繰り返す囘數
+constexpr int THREADS = 8;
+constexpr int TILE_SIZE = 32;
+
+
+/// 轉送命令
+struct Blit
+{
+  int sprite;
+  int x;
+  int y;
+  int z;
+};
+
+
+/// 背景
+void paintBackground(eunomia::Picture& pict)
+{
+  for (int y = 0; y < HEIGHT; ++y)
+    for (int x = 0; x < WIDTH; ++x)
+      pict.pixel(x, y) = eunomia::RgbColour(x & 0xFF, y & 0xFF, 64);
+}
+
+
+/// 點(x, y)が變更範圍に含まれるか
+bool contains(const eunomia::DamageRegion& damage, int x, int y)
+{
+  for (const auto& r : damage.rects())
+    if (x >= r.left && x < r.right && y >= r.top && y < r.bottom)
+      return true;
+  return false;
+}
+
+
+bool sameRects(
+  const eunomia::DamageRegion& a, const eunomia::DamageRegion& b)
+{
+  if (a.rects().size() != b.rects().size())
+    return false;
+  for (std::size_t i = 0; i < a.rects().size(); ++i) {
+    const auto& p = a.rects()[i];
+    const auto& q = b.rects()[i];
+    if (p.left != q.left || p.top != q.top
+        || p.right != q.right || p.bottom != q.bottom)
+      return false;
+  }
+  return true;
+}
+
+
+}//end of namespace
+
+
+int main()
+{
+  using eunomia::RgbaColour;
+
+  // 半透明な轉送元
+  std::vector<std::unique_ptr<eunomia::PictureRgba>> sprites;
+  for (int k = 0; k < 4; ++k) {
+    int sz = 16 + 24 * k;
+    auto sp = eunomia::PictureRgba::create(sz, sz);
+    for (int y = 0; y < sz; ++y)
+      for (int x = 0; x < sz; ++x)
+        sp->pixel(x, y)
+          = RgbaColour(x * 4 + k * 40, y * 4, 200 - k * 30, (x + y + k) * 5);
+    sprites.push_back(std::move(sp));
+  }
+
+  // 畫面から少しはみ出す範圍に置く
+  std::mt19937 rng(4321);
+  std::vector<Blit> blits(SPRITES);
+  for (auto& b : blits) {
+    b.sprite = rng() % sprites.size();
+    b.x = (int)(rng() % (WIDTH + 80)) - 60;
+    b.y = (int)(rng() % (HEIGHT + 80)) - 60;
+    b.z = rng() % 5;
+  }
+
+  // 一つづつblt()した結果
+  auto expected = eunomia::Picture::create(WIDTH, HEIGHT);
+  paintBackground(*expected);
+  for (int z = 0; z < 5; ++z)
+    for (const auto& b : blits)
+      if (b.z == z)
+        expected->blt(
+          *sprites[b.sprite], 0, 0, sprites[b.sprite]->width(),
+          sprites[b.sprite]->height(), b.x, b.y, std::nullopt,
+          eunomia::AlphaBrendCopier());
+
+  eunomia::Compositor<eunomia::RgbColour> compositor(TILE_SIZE);
+  for (const auto& b : blits)
+    compositor.add(
+      *sprites[b.sprite], 0, 0, sprites[b.sprite]->width(),
+      sprites[b.sprite]->height(), b.x, b.y, b.z,
+      eunomia::AlphaBrendCopier());
+
+  auto pict = eunomia::Picture::create(WIDTH, HEIGHT);
+  auto background = eunomia::Picture::create(WIDTH, HEIGHT);
+  paintBackground(*background);
+
+  int failures = 0;
+  std::optional<eunomia::DamageRegion> first;
+  for (int run = 0; run < RUNS; ++run) {
+    pict->blt(*background, 0, 0, WIDTH, HEIGHT, 0, 0);
+    pict->enableDamageTracking();
+    pict->resetDamage();
+
+    compositor.composite(*pict, std::nullopt, THREADS);
+    const eunomia::DamageRegion& damage = *pict->damage();
+
+    int diff = 0, outside = 0;
+    for (int y = 0; y < HEIGHT; ++y)
+      for (int x = 0; x < WIDTH; ++x) {
+        if (pict->pixel(x, y) != expected->pixel(x, y))
+          ++diff;
+        if (pict->pixel(x, y) != background->pixel(x, y)
+            && !contains(damage, x, y))
+          ++outside;
+      }
+
+    bool same = true;
+    if (!first)
+      first = damage;
+    else
+      same = sameRects(*first, damage);
+
+    if (diff || outside || !same) {
+      std::cerr << "run " << run << ": " << diff << " pixels differ, "
+                << outside << " changed pixels outside the damage, "
+                << (same ? "same" : "different") << " damage rects"
+                << std::endl;
+      ++failures;
+    }
+    pict->disableDamageTracking();
+  }
+
+  std::cout << (failures ? "NG" : "ok") << " composite with damage tracking ("
+            << first->rects().size() << " rects)" << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+//eof
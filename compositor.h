@@ -0,0 +1,386 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file compositor.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 轉送命令をタイル毎にまとめて處理する合成器
+ *
+ * @date 2026.10.17 作成
+ * @date 2026.10.17 竝列合成時の變更範圍の記録を呼び出し側のスレッドで行ふやうに修正
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_COMPOSITOR_H
+#define INCLUDE_GUARD_EUNOMIA_COMPOSITOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "imagebuffer.h"
+#include "noncopyable.h"
+#include "parallel.h"
+#include "rect.h"
+#include "scopeguard.h"
+#include "sprite_rle.h"
+
+
+namespace eunomia
+{
+
+/**
+ * @brief 轉送命令をタイル毎にまとめて處理する合成器
+ *
+ * 轉送元、轉送先座標、copier、重ね順(z)から成る轉送命令を溜めておき、
+ * composite()で轉送先畫像をタイルに分けて、タイル毎に
+ * そのタイルに掛かる全ての命令を處理する。
+ * 一枚のタイルに對する處理が續くため、轉送先の畫素がキャッシュに留まり易い。
+ * また、別々のタイルは別々のスレッドで處理することができる。
+ *
+ * 命令はzの小さいものから順に、zが等しいものは追加した順に處理され、
+ * 結果はその順に一つづつImageBuffer::blt()を呼び出した場合と一致する。
+ * 但し、copierは畫素毎に獨立してゐなければならない。
+ * 呼び出し毎に内部状態を變へるcopierを與へた場合の結果は不定である。
+ *
+ * 命令は轉送元を參照で保持するため、
+ * 轉送元はcomposite()の呼び出しが終はるまで破棄してはならない。
+ * また、轉送元と轉送先は異なる畫像バッファでなければならない。
+ */
+template<class C_>
+class Compositor : Noncopyable<Compositor<C_>>
+{
+public:
+  /// @brief タイルの一邊の既定の畫素數
+  static constexpr int DEFAULT_TILE_SIZE = 128;
+  /// @brief タイルの一邊の最小の畫素數
+  static constexpr int MIN_TILE_SIZE = 8;
+
+private:
+  /// @brief 轉送命令
+  struct Command_
+  {
+    Rect bounds;  ///< 轉送先で變更され得る範圍
+    int z;        ///< 重ね順
+    /// 轉送先と變更を許す範圍を與へて轉送を行ふ
+    std::function<void(ImageBuffer<C_>&, const Rect&)> apply;
+  };
+
+  int tileSize_;  ///< タイルの一邊の畫素數
+  std::vector<Command_> commands_;  ///< 轉送命令
+  std::vector<std::size_t> order_;  ///< 處理順に竝べた命令の番號
+  std::vector<std::vector<std::size_t>> bins_;  ///< タイル毎の命令の番號
+
+  /// @brief 範圍をintに收めた長方形
+  static Rect bounds_(long long l, long long t, long long r, long long b)
+    noexcept
+  {
+    auto c = [](long long v) {
+      return static_cast<int>(std::clamp<long long>(v, INT_MIN, INT_MAX));
+    };
+    return Rect(c(l), c(t), c(r), c(b));
+  }
+
+  void push_(
+    const Rect& bounds, int z,
+    std::function<void(ImageBuffer<C_>&, const Rect&)>&& apply)
+  {
+    if (bounds.left < bounds.right && bounds.top < bounds.bottom)
+      commands_.push_back(Command_{bounds, z, std::move(apply)});
+  }
+
+public:
+  /// @brief 構築子
+  /// @param tileSize
+  ///   タイルの一邊の畫素數。MIN_TILE_SIZEより小さい場合はMIN_TILE_SIZE。
+  explicit Compositor(int tileSize = DEFAULT_TILE_SIZE) noexcept
+    : tileSize_(std::max(tileSize, MIN_TILE_SIZE))
+    {}
+
+  /// @brief タイルの一邊の畫素數
+  int tileSize() const noexcept { return tileSize_; }
+
+  /// @brief 溜めてゐる命令の數
+  std::size_t size() const noexcept { return commands_.size(); }
+
+  /// @brief 命令を溜めてゐなければtrue
+  bool empty() const noexcept { return commands_.empty(); }
+
+  /// @brief 溜めてゐる命令の破棄
+  ///
+  /// 作業用の記憶領域は解放せず、次のフレームで再利用する。
+  void clear() noexcept { commands_.clear(); }
+
+
+  /// @brief 轉送命令の追加
+  ///
+  /// ImageBuffer::blt()と同じ轉送を命令として追加する。
+  /// 轉送先で變更され得る範圍が空の命令は追加しない。
+  ///
+  /// @param src 轉送元畫像バッファ
+  /// @param sx 轉送元左上X座標
+  /// @param sy 轉送元左上Y座標
+  /// @param w 轉送幅
+  /// @param h 轉送高さ
+  /// @param dx 左上X座標
+  /// @param dy 左上Y座標
+  /// @param z 重ね順。小さいものから先に處理される。
+  /// @param copier ImageBuffer::blt()に同じ。
+  template<class CSrc, class Copier>
+  void
+  add(
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, int z, Copier copier)
+  {
+    long long sl = std::max(sx, 0);
+    long long st = std::max(sy, 0);
+    long long sr = std::min<long long>((long long)sx + w, src.width());
+    long long sb = std::min<long long>((long long)sy + h, src.height());
+
+    push_(
+      bounds_(
+        dx + (sl - sx), dy + (st - sy), dx + (sr - sx), dy + (sb - sy)),
+      z,
+      [&src, sx, sy, w, h, dx, dy, copier](
+        ImageBuffer<C_>& dst, const Rect& clip) {
+          dst.blt(src, sx, sy, w, h, dx, dy, clip, copier);
+      });
+  }
+
+  /// @brief 轉送命令の追加
+  ///
+  /// 畫素を轉送元の畫素で置き換へる命令を追加する。
+  template<class CSrc>
+  void
+  add(
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, int z)
+  {
+    add(src, sx, sy, w, h, dx, dy, z, AssignCopier());
+  }
+
+  /// @brief スプライトの轉送命令の追加
+  ///
+  /// ImageBuffer::blt()によるスプライトの轉送を命令として追加する。
+  ///
+  /// @param src 轉送元スプライト
+  /// @param dx 左上X座標
+  /// @param dy 左上Y座標
+  /// @param z 重ね順
+  /// @param opaque 不透明な連の轉寫に用ゐる。
+  /// @param copier 半透明な連の轉寫に用ゐる。
+  template<class CSrc, class OpaqueCopier, class Copier>
+  void
+  add(
+    const SpriteRle<CSrc>& src, int dx, int dy, int z,
+    OpaqueCopier opaque, Copier copier)
+  {
+    push_(
+      bounds_(
+        dx, dy, (long long)dx + src.width(), (long long)dy + src.height()),
+      z,
+      [&src, dx, dy, opaque, copier](ImageBuffer<C_>& dst, const Rect& clip) {
+        dst.blt(src, dx, dy, clip, opaque, copier);
+      });
+  }
+
+  /// @brief スプライトの轉送命令の追加
+  ///
+  /// 全ての連の畫素にcopierを用ゐる。
+  template<class CSrc, class Copier>
+  void
+  add(const SpriteRle<CSrc>& src, int dx, int dy, int z, Copier copier)
+  {
+    add(src, dx, dy, z, copier, copier);
+  }
+
+  /// @brief スプライトの轉送命令の追加
+  ///
+  /// 連の畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void add(const SpriteRle<CSrc>& src, int dx, int dy, int z)
+  {
+    add(src, dx, dy, z, AssignCopier(), AssignCopier());
+  }
+
+
+  /// @brief 合成
+  ///
+  /// 溜めてゐる命令をdstに對して處理する。
+  /// cliprectとdstの範圍をタイルに分け、タイルを高々threads個の
+  /// スレッドに動的に割り振る。
+  /// 合成の後も命令は殘るので、次のフレームの前にclear()を呼ぶこと。
+  /// dstが變更範圍を追跡してゐる場合は、cliprectとdstの範圍に切り詰めた
+  /// 各命令の範圍を呼び出したスレッドで記録する。
+  ///
+  /// @param dst 轉送先畫像バッファ
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param threads スレッド數
+  void
+  composite(
+    ImageBuffer<C_>& dst, const std::optional<Rect>& cliprect, int threads);
+
+  /// @brief 合成
+  ///
+  /// 呼び出したスレッドのみで合成する。
+  void
+  composite(
+    ImageBuffer<C_>& dst, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    composite(dst, cliprect, 1);
+  }
+
+  /// @brief 合成
+  ///
+  /// 實行ポリシーに應じたスレッド數で合成する。
+  /// @param policy execution::seq、execution::parなど
+  template<class Policy>
+    requires isExecutionPolicy<Policy>
+  void
+  composite(
+    Policy&& policy,
+    ImageBuffer<C_>& dst, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    composite(dst, cliprect, threadCountFor(policy));
+  }
+};
+
+
+}//end of namespace eunomia
+
+
+
+
+template<class C_>
+inline
+void
+eunomia::Compositor<C_>::composite(
+  eunomia::ImageBuffer<C_>& dst, const std::optional<Rect>& cliprect,
+  int threads)
+{
+  // 處理する範圍
+  Rect area(0, 0, dst.width(), dst.height());
+  if (cliprect) {
+    area.left = std::max(area.left, cliprect->left);
+    area.top = std::max(area.top, cliprect->top);
+    area.right = std::min(area.right, cliprect->right);
+    area.bottom = std::min(area.bottom, cliprect->bottom);
+  }
+  if (area.left >= area.right || area.top >= area.bottom || empty())
+    return;
+
+  const int ts = tileSize_;
+  const int ntx = (area.width() + ts - 1) / ts;
+  const int nty = (area.height() + ts - 1) / ts;
+  const std::size_t ntiles = (std::size_t)ntx * nty;
+
+  // 重ね順に竝べる。zの等しい命令は追加順を保つ。
+  order_.resize(commands_.size());
+  for (std::size_t i = 0; i < order_.size(); ++i)
+    order_[i] = i;
+  std::stable_sort(
+    order_.begin(), order_.end(),
+    [this](std::size_t a, std::size_t b) {
+      return commands_[a].z < commands_[b].z;
+    });
+
+  // 變更範圍は各命令の範圍としてこのスレッドで記録する。
+  // タイル毎の轉送は複數のスレッドから行ふので、その間は
+  // dstから變更範圍を外し、轉送毎には記録させない。
+  std::optional<DamageRegion> damage = std::move(dst.damage_);
+  dst.damage_.reset();
+  auto restore
+    = makeScopeGuard([&dst, &damage] { dst.damage_ = std::move(damage); });
+
+  // タイル毎に振り分ける。各タイルの命令は處理順に竝ぶ。
+  if (bins_.size() < ntiles)
+    bins_.resize(ntiles);
+  for (std::size_t t = 0; t < ntiles; ++t)
+    bins_[t].clear();
+
+  for (auto i : order_) {
+    const Rect& b = commands_[i].bounds;
+    int l = std::max(b.left, area.left);
+    int t = std::max(b.top, area.top);
+    int r = std::min(b.right, area.right);
+    int btm = std::min(b.bottom, area.bottom);
+    if (l >= r || t >= btm)
+      continue;
+
+    if (damage)
+      damage->add(Rect(l, t, r, btm));
+
+    int tx0 = (l - area.left) / ts;
+    int tx1 = (r - 1 - area.left) / ts;
+    int ty0 = (t - area.top) / ts;
+    int ty1 = (btm - 1 - area.top) / ts;
+    for (int ty = ty0; ty <= ty1; ++ty)
+      for (int tx = tx0; tx <= tx1; ++tx)
+        bins_[(std::size_t)ty * ntx + tx].push_back(i);
+  }
+
+  // タイル毎の合成
+  auto tile = [&](std::size_t k) {
+    int tx = (int)(k % ntx);
+    int ty = (int)(k / ntx);
+    Rect clip(
+      area.left + tx * ts, area.top + ty * ts,
+      std::min(area.left + (tx + 1) * ts, area.right),
+      std::min(area.top + (ty + 1) * ts, area.bottom));
+    for (auto i : bins_[k])
+      commands_[i].apply(dst, clip);
+  };
+
+  threads
+    = std::min<long long>(
+        implement_::threadsForArea_(threads, area.width(), area.height()),
+        ntiles);
+  if (threads <= 1) {
+    for (std::size_t k = 0; k < ntiles; ++k)
+      tile(k);
+    return;
+  }
+
+  // 各スレッドが空いたタイルを順に取つて處理する
+  std::atomic<std::size_t> next(0);
+  implement_::parallelRows_(
+    threads, threads,
+    [&](int, int) {
+      for (auto k = next++; k < ntiles; k = next++)
+        tile(k);
+    });
+}
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_COMPOSITOR_H
+
+
+
+//eof
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file damage.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像の變更された範圍の集合
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_DAMAGE_H
+#define INCLUDE_GUARD_EUNOMIA_DAMAGE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "rect.h"
+
+
+namespace eunomia
+{
+
+/**
+ * @brief 畫像の變更された範圍の集合
+ *
+ * 長方形を追加する度に、重なるものや隣り合ふものを統合し、
+ * 高々MAX_RECTS個の長方形で變更された範圍を覆ふ。
+ * 長方形の右端、下端は範圍に含まない。
+ * 統合により、實際には變更されてゐない畫素を含むことがある。
+ */
+class DamageRegion
+{
+public:
+  /// @brief 保持する長方形の最大數
+  static constexpr std::size_t MAX_RECTS = 16;
+
+private:
+  std::vector<Rect> rects_;  ///< 互ひに統合できない長方形
+
+  static long long area_(const Rect& r) noexcept
+    { return (long long)r.width() * r.height(); }
+
+  static Rect union_(const Rect& a, const Rect& b) noexcept
+  {
+    return
+      Rect(
+        std::min(a.left, b.left), std::min(a.top, b.top),
+        std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+  }
+
+public:
+  /// @brief 構築子
+  ///
+  /// 記憶領域を豫め確保し、以後のadd()で再確保が起きないやうにする。
+  /// 確保に失敗した場合はstd::bad_allocを投げる。
+  DamageRegion() { rects_.reserve(MAX_RECTS + 1); }
+
+  /// @brief 範圍の追加
+  ///
+  /// 既存の長方形との外接長方形の面積が兩者の面積の和を超えない場合、
+  /// 即ち兩者が重なるか無駄なく隣り合ふ場合は統合する。
+  /// 長方形がMAX_RECTS個を超えた場合は、統合による面積の增分が
+  /// 最も小さい二つを統合する。
+  /// 幅や高さが0以下の長方形は無視する。
+  void add(const Rect& rect);
+
+  /// @brief 範圍を成す長方形
+  const std::vector<Rect>& rects() const noexcept { return rects_; }
+
+  /// @brief 範圍が空ならばtrue
+  bool empty() const noexcept { return rects_.empty(); }
+
+  /// @brief 範圍全體の外接長方形
+  ///
+  /// 範圍が空の場合はRect(0, 0, 0, 0)を返す。
+  Rect bounds() const noexcept
+  {
+    if (rects_.empty())
+      return Rect(0, 0, 0, 0);
+    Rect r = rects_.front();
+    for (const auto& e : rects_)
+      r = union_(r, e);
+    return r;
+  }
+
+  /// @brief 範圍を空にする
+  void clear() noexcept { rects_.clear(); }
+};
+
+
+namespace implement_
+{
+
+/// @brief 擴大縮小先で影響を受ける範圍
+///
+/// 幅sw、高さshの畫像の長方形rectの範圍が變更されたとき、
+/// それを幅dw、高さdhに擴大縮小した畫像で再計算を要する範圍を返す。
+/// marginは擴大縮小に用ゐる近傍の元畫像上の半徑(畫素數)。
+/// 浮動小數點數の誤差に備へ、更に1畫素廣く取る。
+inline
+Rect
+resizedDamage_(
+  const Rect& rect, int sw, int sh, int dw, int dh, int margin) noexcept
+{
+  if (sw <= 0 || sh <= 0)
+    return Rect(0, 0, 0, 0);
+
+  double rx = (double)dw / sw;
+  double ry = (double)dh / sh;
+  auto lo = [](double v, int limit) {
+    return (int)std::clamp(std::floor(v) - 1.0, 0.0, (double)limit);
+  };
+  auto hi = [](double v, int limit) {
+    return (int)std::clamp(std::ceil(v) + 1.0, 0.0, (double)limit);
+  };
+
+  return
+    Rect(
+      lo((rect.left - margin) * rx, dw), lo((rect.top - margin) * ry, dh),
+      hi((rect.right + margin) * rx, dw), hi((rect.bottom + margin) * ry, dh));
+}
+
+}// end of namespace implement_
+
+
+}// end of namespace eunomia
+
+
+
+
+inline
+void
+eunomia::DamageRegion::add(const eunomia::Rect& rect)
+{
+  if (rect.left >= rect.right || rect.top >= rect.bottom)
+    return;
+
+  // 統合できる長方形が無くなるまで統合を繰り返す
+  Rect cur = rect;
+  for (bool merged = true; merged; ) {
+    merged = false;
+    for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+      Rect u = union_(*it, cur);
+      if (area_(u) <= area_(*it) + area_(cur)) {
+        cur = u;
+        rects_.erase(it);
+        merged = true;
+        break;
+      }
+    }
+  }
+  rects_.push_back(cur);
+
+  if (rects_.size() <= MAX_RECTS)
+    return;
+
+  // 統合による面積の增分が最も小さい二つを統合する
+  std::size_t bi = 0, bj = 1;
+  long long best = -1;
+  for (std::size_t i = 0; i < rects_.size(); ++i)
+    for (std::size_t j = i + 1; j < rects_.size(); ++j) {
+      long long waste
+        = area_(union_(rects_[i], rects_[j]))
+          - area_(rects_[i]) - area_(rects_[j]);
+      if (best < 0 || waste < best) {
+        best = waste;
+        bi = i;
+        bj = j;
+      }
+    }
+
+  Rect u = union_(rects_[bi], rects_[bj]);
+  rects_.erase(rects_.begin() + bj);
+  rects_.erase(rects_.begin() + bi);
+  add(u);
+}
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_DAMAGE_H
+
+
+
+//eof
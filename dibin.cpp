@@ -34,9 +34,13 @@
  * @date 2018.12.28 資源管理をunique_ptrに移行
  * @date 2019.8.29 new[]をmake_uniqueに置換
  * @date 2021.4.29 LIBPOLYMNIAからLIBEUNOMIAに移植
+ * @date 2026.10.17 24bit、32bitの讀み込みをライン單位に變更し、
+ *                  バッファ長をstd::size_tで計算するやうに變更
+ * @date 2026.10.17 讀み込み先の畫像を初期化せずに生成するやうに變更
  *
  */
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <fstream>
 #include <new>
@@ -180,8 +184,8 @@ bool readPalette_(std::istream& is, eunomia::RgbColour pal[], int npal)
 /*
  * @brief Bitmapの1lineのバッファ長の算出
  */
-inline constexpr int getBufSize_(int l) noexcept
-  { return (l + 3) & ~3; }
+inline constexpr std::size_t getBufSize_(std::size_t l) noexcept
+  { return (l + 3) & ~std::size_t(3); }
 
 
 /*
@@ -231,26 +235,26 @@ read04_oneline_(std::uint8_t src[], int width, std::uint8_t dst[])
 bool read24bit_(std::istream& is, eunomia::Picture& pict)
 {
   int width = pict.width();
-  int height = pict.height();
+  auto linesize = getBufSize_(static_cast<std::size_t>(width) * 3);
 
-  int linesize = getBufSize_(width * 3);
-
-  std::unique_ptr<std::uint8_t[]> imgbuf;
+  std::unique_ptr<std::uint8_t[]> linebuf;
   try {
-    imgbuf = std::make_unique<std::uint8_t[]>(linesize * height);
+    linebuf = std::make_unique<std::uint8_t[]>(linesize);
   }
   catch(std::bad_alloc&) {
     return false;
   }
 
-  is.read((char*)(imgbuf.get()), linesize * height);
+  for (int y = pict.height() - 1; y >= 0; --y) {
+    if (!is.read((char*)(linebuf.get()), linesize))
+      return false;
 
-  for (int y = height - 1, l = 0; y >= 0; --y, l += linesize) {
     auto lb = pict.lineBuffer(y);
-    for (int x = 0, k = 0; x < width; ++x, k += 3) {
-      lb[x].red = imgbuf[l + k + 2];
-      lb[x].green = imgbuf[l + k + 1];
-      lb[x].blue = imgbuf[l + k];
+    const std::uint8_t* q = linebuf.get();
+    for (int x = 0; x < width; ++x, q += 3) {
+      lb[x].red = q[2];
+      lb[x].green = q[1];
+      lb[x].blue = q[0];
     }
   }
 
@@ -264,26 +268,26 @@ bool read24bit_(std::istream& is, eunomia::Picture& pict)
 bool read32bit_(std::istream& is, eunomia::Picture& pict)
 {
   int width = pict.width();
-  int height = pict.height();
+  auto linesize = getBufSize_(static_cast<std::size_t>(width) * 4);
 
-  int linesize = getBufSize_(width * 4);
-
-  std::unique_ptr<std::uint8_t[]> imgbuf;
+  std::unique_ptr<std::uint8_t[]> linebuf;
   try {
-    imgbuf = std::make_unique<std::uint8_t[]>(linesize * height);
+    linebuf = std::make_unique<std::uint8_t[]>(linesize);
   }
   catch(std::bad_alloc&) {
     return false;
   }
 
-  is.read((char*)(imgbuf.get()), linesize * height);
+  for (int y = pict.height() - 1; y >= 0; --y) {
+    if (!is.read((char*)(linebuf.get()), linesize))
+      return false;
 
-  for (int y = height - 1, l = 0; y >= 0; --y, l += linesize) {
     auto lb = pict.lineBuffer(y);
-    for (int x = 0, k = 0; x < width; ++x, k += 4) {
-      lb[x].red = imgbuf[l + k + 2];
-      lb[x].green = imgbuf[l + k + 1];
-      lb[x].blue = imgbuf[l + k];
+    const std::uint8_t* q = linebuf.get();
+    for (int x = 0; x < width; ++x, q += 4) {
+      lb[x].red = q[2];
+      lb[x].green = q[1];
+      lb[x].blue = q[0];
     }
   }
 
@@ -297,7 +301,7 @@ bool read32bit_(std::istream& is, eunomia::Picture& pict)
 bool read01bit_(std::istream& is, eunomia::PictureIndexed& pict)
 {
   int width = pict.width();
-  int bufsize = getBufSize_((width + 7) / 8);
+  auto bufsize = getBufSize_((static_cast<std::size_t>(width) + 7) / 8);
 
   std::unique_ptr<std::uint8_t[]> linebuf;
   try {
@@ -325,7 +329,7 @@ bool read01bit_(std::istream& is, eunomia::PictureIndexed& pict)
 bool read04bit_(std::istream& is, eunomia::PictureIndexed& pict)
 {
   int width = pict.width();
-  int bufsize = getBufSize_((width + 1) / 2);
+  auto bufsize = getBufSize_((static_cast<std::size_t>(width) + 1) / 2);
   std::unique_ptr<std::uint8_t[]> linebuf;
   try {
     linebuf = std::make_unique<std::uint8_t[]>(bufsize);
@@ -352,7 +356,7 @@ bool read04bit_(std::istream& is, eunomia::PictureIndexed& pict)
 bool read08bit_(std::istream& is, eunomia::PictureIndexed& pict)
 {
   int width = pict.width();
-  int bufsize = getBufSize_(width);
+  auto bufsize = getBufSize_(width);
   std::unique_ptr<std::uint8_t[]> linebuf;
   try {
     linebuf = std::make_unique<std::uint8_t[]>(bufsize);
@@ -383,7 +387,9 @@ loadDibPictureIndexed_(
   const Info_& info,
   std::unique_ptr<eunomia::PictureIndexed>& upindx)
 {
-  upindx = eunomia::PictureIndexed::create(info.width, info.height);
+  upindx
+    = eunomia::PictureIndexed::create(
+        info.width, info.height, eunomia::InitPolicy::Uninitialized);
 
   if (!upindx)
     return false;
@@ -424,7 +430,9 @@ loadDibPicture_(
   const Info_& info,
   std::unique_ptr<eunomia::Picture>& uppict)
 {
-  uppict = eunomia::Picture::create(info.width, info.height);
+  uppict
+    = eunomia::Picture::create(
+        info.width, info.height, eunomia::InitPolicy::Uninitialized);
 
   if (uppict) {
     if (info.bpp == 24) {
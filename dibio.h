@@ -30,6 +30,7 @@
  *  @brief DIB形式畫像入出力
  *
  *  @date 2021.4.29 v0.1
+ *  @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
  *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_DIB_INPUT_OUTPUT_H
@@ -70,11 +71,13 @@ loadDib(
  * @brief DIBファイルの保存
  *
  * 畫像をDIB形式で保存する。
+ * PictureのほかImageView<RgbColour>なども保存できる。
  * @param path 保存すべきDIBファイルのパス
  * @param pict 保存する畫像
  * @return 成功時にはtrue、さもなくばfalseを返す。
  */
-bool saveDib(const Picture& pict, const std::filesystem::path& path);
+bool
+saveDib(const ImageBuffer<RgbColour>& pict, const std::filesystem::path& path);
 
 /**
  * @brief DIBファイルの保存
@@ -86,6 +89,21 @@ bool saveDib(const Picture& pict, const std::filesystem::path& path);
  */
 bool saveDib(const PictureIndexed& pict, const std::filesystem::path& path);
 
+/**
+ * @brief DIBファイルの保存
+ *
+ * インデックスカラーの畫像を、パレットを別途指定してDIB形式で保存する。
+ * PictureIndexedの部分畫像(ImageView<std::uint8_t>)などを保存するのに用ゐる。
+ * @param pict 保存する畫像
+ * @param palette 要素數256のパレット
+ * @param path 保存すべきDIBファイルのパス
+ * @return 成功時にはtrue、さもなくばfalseを返す。
+ */
+bool
+saveDib(
+  const ImageBuffer<std::uint8_t>& pict, const RgbColour palette[],
+  const std::filesystem::path& path);
+
 
 }// end of namespace eunomia
 
@@ -32,11 +32,16 @@
  * @date 2018.12.23 C++17對應
  * @date 2019.8.29 new[]をmake_uniqueに置換
  * @date 2021.4.29 LIBPOLYMNIAからLIBEUNOMIAに移植
+ * @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
+ * @date 2026.10.17 バッファ長をstd::size_tで計算し、
+ *                  ファイルサイズが32bitに收まらない畫像を弾くやうに變更
  *
  */
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include "dibio.h"
 
@@ -44,10 +49,27 @@
 namespace
 {
 
+/*
+ * @brief ビットマップデータの最大バイト數
+ *
+ * DIBのファイルサイズは32bitで記録されるため、
+ * ヘッダと256色分のパレットを除いた大きさまでしか書き出せない。
+ */
+constexpr std::uint64_t MAX_BITSIZE_
+  = std::numeric_limits<std::uint32_t>::max() - 54 - 4 * 256;
+
+
+/*
+ * @brief 1lineのバッファ長の算出
+ */
+inline constexpr std::size_t getBufSize_(std::size_t l) noexcept
+  { return (l + 3) & ~std::size_t(3); }
+
+
 /*
  * @brief DIBヘッダの書き出し
  */
-bool writeHeader_(std::ostream& os, int bitsize, int npal)
+bool writeHeader_(std::ostream& os, std::uint32_t bitsize, int npal)
 {
   std::uint32_t dword;
   std::uint16_t word;
@@ -140,10 +162,11 @@ bool writePalette_(std::ostream& os, const eunomia::RgbColour pal[], int np)
 
 
 /*
- * @brief PictureIndexedの各畫素の書き出し
+ * @brief インデックスカラー畫像の各畫素の書き出し
  */
 bool writeBits_(
-  std::ostream& os, const eunomia::PictureIndexed& pict, int bufsize)
+  std::ostream& os, const eunomia::ImageBuffer<std::uint8_t>& pict,
+  std::size_t bufsize)
 {
   auto linebuf = std::make_unique<std::uint8_t[]>(bufsize);
   std::fill_n(linebuf.get(), bufsize, 0);
@@ -161,7 +184,8 @@ bool writeBits_(
 /* 24bit Bitmapデータ書き出し */
 bool
 writeBits_(
-  std::ostream& os, const eunomia::Picture& pict, int bufsize)
+  std::ostream& os, const eunomia::ImageBuffer<eunomia::RgbColour>& pict,
+  std::size_t bufsize)
 {
   auto linebuf = std::make_unique<std::uint8_t[]>(bufsize);
   std::fill_n(linebuf.get(), bufsize, 0);
@@ -187,18 +211,19 @@ writeBits_(
 
 bool
 eunomia::saveDib(
-  const eunomia::Picture& pict, const std::filesystem::path& path)
+  const eunomia::ImageBuffer<eunomia::RgbColour>& pict,
+  const std::filesystem::path& path)
 {
+  auto bufsize = getBufSize_(static_cast<std::size_t>(pict.width()) * 3);
+  std::uint64_t mapsize = static_cast<std::uint64_t>(bufsize) * pict.height();
+  if (mapsize > MAX_BITSIZE_)
+    return false;
+
   std::ofstream ofs(path, std::ios::out | std::ios::binary);
   if (!ofs)
     return false;
 
-  int bufsize = pict.width() * 3;
-  bufsize = ((bufsize + 3) / 4) * 4;
-
-  int mapsize = bufsize * pict.height();
-
-  writeHeader_(ofs, mapsize, 0);
+  writeHeader_(ofs, static_cast<std::uint32_t>(mapsize), 0);
   writeInfo_(ofs, pict.width(), pict.height(), 24, 0);
   writeBits_(ofs, pict, bufsize);
 
@@ -209,21 +234,31 @@ eunomia::saveDib(
 bool
 eunomia::saveDib(
   const eunomia::PictureIndexed& pict, const std::filesystem::path& path)
+{
+  return saveDib(pict, pict.paletteBuffer(), path);
+}
+
+
+bool
+eunomia::saveDib(
+  const eunomia::ImageBuffer<std::uint8_t>& pict,
+  const eunomia::RgbColour palette[],
+  const std::filesystem::path& path)
 {
   using namespace std;
 
+  auto bufsize = getBufSize_(pict.width());
+  std::uint64_t mapsize = static_cast<std::uint64_t>(bufsize) * pict.height();
+  if (mapsize > MAX_BITSIZE_)
+    return false;
+
   std::ofstream ofs(path, ios::out | ios::binary);
   if (!ofs)
     return false;
 
-  int bufsize = pict.width();
-  bufsize = ((bufsize + 3) / 4) * 4;
-
-  int mapsize = bufsize * pict.height();
-
-  writeHeader_(ofs, mapsize, 256);
+  writeHeader_(ofs, static_cast<std::uint32_t>(mapsize), 256);
   writeInfo_(ofs, pict.width(), pict.height(), 8, 0);
-  writePalette_(ofs, pict.paletteBuffer(), 256);
+  writePalette_(ofs, palette, 256);
   writeBits_(ofs, pict, bufsize);
 
   return true;
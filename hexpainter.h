@@ -33,6 +33,8 @@
  *
  * @date 2021.4.29 v0.1 LIBPOLYMNIAからLIBEUNOMIAに移植
  *
+ * @date 2026.10.17 HEXの塗り潰しをfillPolygon()で行ふやうに變更
+ *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_HEX_PAINTER_H
 #define INCLUDE_GUARD_EUNOMIA_HEX_PAINTER_H
@@ -234,10 +236,10 @@ private:
     q4 = q + r_;
   }
 
-  /// @brief HEXの左半の塗り潰し
-  void fillLeftHalf_(ImageBuffer<C_>& pict, int x, int y, const C_& color);
-  /// @brief HEXの右半の塗り潰し
-  void fillRightHalf_(ImageBuffer<C_>& pict, int x, int y, const C_& color);
+  /// @brief HEXの内部の塗り潰し
+  ///
+  /// 中心が内側にある畫素のみを塗る。邊の上の畫素は塗らない。
+  void fillInside_(ImageBuffer<C_>& pict, int x, int y, const C_& color);
 };
 
 
@@ -319,111 +321,31 @@ inline
 void
 HexPainter<C_>::fill(ImageBuffer<C_>& pict, int x, int y, const C_& color)
 {
-  fillLeftHalf_(pict, x, y, color);
-  fillRightHalf_(pict, x, y, color);
-}
+  fillInside_(pict, x, y, color);
 
-template<class C_>
-inline
-void
-HexPainter<C_>::fillLeftHalf_(
-  ImageBuffer<C_>& pict, int x, int y, const C_& color)
-{
-  // 頂點の座標の算出
-  double p, q;
-  getPixelPosition(x, y, p, q);
-  int p1, p2;
-  int q1, q2, q3, q4;
-  calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-
-  // 塗り潰し
-  int dp = (int)p - p1;
-  int dq1 = q2 - q1;
-  int dq2 = q4 - q3;
-
-  int pp1 = p1;
-  int pp2 = p;
-  int qq1 = q2;
-  int qq2 = q1;
-  int qq3 = q3;
-  int qq4 = q4;
-
-  int e1 = -dp;
-  int e2 = -dp;
-  int lx = (dp + 1) / 2;
-  for (int i = 0; i < lx; i++) {
-    pict.line(pp1, qq1, pp1, qq3, color);
-    pict.line(pp2, qq2, pp2, qq4, color);
-
-    pp1++;
-    pp2--;
-
-    e1 += 2 * dq1;
-    if (e1 >= 0) {
-      qq1--;
-      qq2++;
-      e1 -= 2 * dp;
-    }
-    e2 += 2 * dq2;
-    if (e2 >= 0) {
-      qq3++;
-      qq4--;
-      e2 -= 2 * dp;
-    }
-  }
-  if (!(dp % 2))
-    pict.line(pp1, qq1, pp1, qq3, color);
+  // fillPolygon()は中心が内側にある畫素しか塗らないので、
+  // 邊の上の畫素は外周の線で塗る
+  draw(pict, x, y, color);
 }
 
+
 template<class C_>
 inline
 void
-HexPainter<C_>::fillRightHalf_(
+HexPainter<C_>::fillInside_(
   ImageBuffer<C_>& pict, int x, int y, const C_& color)
 {
-  // 頂點の座標の算出
   double p, q;
   getPixelPosition(x, y, p, q);
   int p1, p2;
   int q1, q2, q3, q4;
   calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
 
-  // 塗り潰し
-  int dp = p2 - (int)p;
-  int dq1 = q2 - q1;
-  int dq2 = q4 - q3;
-  int pp1 = p;
-  int pp2 = p2;
-  int qq1 = q1;
-  int qq2 = q2;
-  int qq3 = q4;
-  int qq4 = q3;
-
-  int e1 = -dp;
-  int e2 = -dp;
-  int lx = (dp + 1) / 2;
-  for (int i = 0; i < lx; i++) {
-    pict.line(pp1, qq1, pp1, qq3, color);
-    pict.line(pp2, qq2, pp2, qq4, color);
-
-    pp1++;
-    pp2--;
-
-    e1 += 2 * dq1;
-    if (e1 >= 0) {
-      qq1++;
-      qq2--;
-      e1 -= 2 * dp;
-    }
-    e2 += 2 * dq2;
-    if (e2 >= 0) {
-      qq3--;
-      qq4++;
-      e2 -= 2 * dp;
-    }
-  }
-  if (!(dp % 2))
-    pict.line(pp1, qq1, pp1, qq3, color);
+  // 走査線毎に塗り潰す
+  const Point vertices[] = {
+    {(int)p, q1}, {p2, q2}, {p2, q3}, {(int)p, q4}, {p1, q3}, {p1, q2}
+  };
+  pict.fillPolygon(vertices, color);
 }
 
 
@@ -433,180 +355,12 @@ void
 HexPainter<C_>::fill(
   ImageBuffer<C_>& pict, int x, int y, int w, int h, const C_& color)
 {
-  // 使ひ廻す變數
-  double p, q;
-  int p1, p2;
-  int q1, q2, q3, q4;
-
-  // 中央の「箱」の塗り潰し
-  int pbox0, qbox0, pbox1, qbox1;
-  if (y % 2 == 0) {
-    getPixelPosition(x, y, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    pbox0 = p;
-    qbox0 = q2;
-
-    getPixelPosition(x + w - 1, y, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    pbox1 = p2;
-
-    getPixelPosition(x + w - 1, y + h - 1, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    qbox1 = q3;
-  } else {
-    getPixelPosition(x, y, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    pbox0 = p1;
-    qbox0 = q2;
-
-    getPixelPosition(x + w - 1, y, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    pbox1 = p;
-
-    getPixelPosition(x + w - 1, y + h - 1, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-    qbox1 = q3;
-  }
-  pict.box(pbox0, qbox0, pbox1, qbox1, color, true);
-
-  // 左端の塗り潰し
-  for (int j = 0; j < h; j++) {
-    if ((y + j) % 2 == 0) {
-      fillLeftHalf_(pict, x, y + j, color);
-    }
-  }
-
-  // 右端の塗り潰し
-  for (int j = 0; j < h; j++) {
-    if ((y + j) % 2 != 0) {
-      fillRightHalf_(pict, x + w - 1, y + j, color);
-    }
-  }
-
-  for (int i = 0; i < w; i++) {
-    int dp, dq; //dq1, dq2;
-    int pp1, pp2, qq1, qq2; //, qq3, qq4;
-    int e, lx;
-
-    // 上端三角形の塗り潰し
-    getPixelPosition(x + i, y, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-
-    //// 左半分の塗り潰し
-    dp = (int)p - p1;
-    dq = q2 - q1;
-
-    pp1 = p1;
-    pp2 = p;
-    qq1 = q2;
-    qq2 = q1;
-
-    e = -dp;
-    lx = (dp + 1) / 2;
-    for (int i = 0; i < lx; i++) {
-      pict.line(pp1, qq1, pp1, q2, color);
-      pict.line(pp2, qq2, pp2, q2, color);
-
-      pp1++;
-      pp2--;
-      e += 2 * dq;
-      if (e >= 0) {
-        qq1--;
-        qq2++;
-        e -= 2 * dp;
-      }
-    }
-    if (!(dp % 2))
-      pict.line(pp1, qq1, pp1, q2, color);
-
-    //// 右半分の塗り潰し
-    dp = p2 - (int)p;
-    ////dqは左半分と全く同じ
-    pp1 = p;
-    pp2 = p2;
-    qq1 = q1;
-    qq2 = q2;
-
-    e = -dp;
-    lx = (dp + 1) / 2;
-    for (int i = 0; i < lx; i++) {
-      pict.line(pp1, qq1, pp1, q2, color);
-      pict.line(pp2, qq2, pp2, q2, color);
-
-      pp1++;
-      pp2--;
-
-      e += 2 * dq;
-      if (e >= 0) {
-        qq1++;
-        qq2--;
-        e -= 2 * dp;
-      }
-    }
-    if (!(dp % 2))
-      pict.line(pp1, qq1, pp1, q2, color);
-
-
-    // 下端三角形の塗り潰し
-    getPixelPosition(x + i, y + h - 1, p, q);
-    calcVertex_(p1, p2, q1, q2, q3, q4, p, q);
-
-    //// 左半分の塗り潰し
-    dp = (int)p - p1;
-    dq = q4 - q3;
-
-    pp1 = p1;
-    pp2 = p;
-    qq1 = q3;
-    qq2 = q4;
-
-    e = -dp;
-    lx = (dp + 1) / 2;
-    for (int i = 0; i < lx; i++) {
-      pict.line(pp1, q3, pp1, qq1, color);
-      pict.line(pp2, q3, pp2, qq2, color);
-
-      pp1++;
-      pp2--;
-
-      e += 2 * dq;
-      if (e >= 0) {
-        qq1++;
-        qq2--;
-        e -= 2 * dp;
-      }
-    }
-    if (!(dp % 2))
-      pict.line(pp1, q3, pp1, qq1, color);
-
-    //// 右半分
-    dp = p2 - (int)p;
-    ////dqは左半分と全く同じ
-    pp1 = p;
-    pp2 = p2;
-    qq1 = q4;
-    qq2 = q3;
-
-    e = -dp;
-    lx = (dp + 1) / 2;
-    for (int i = 0; i < lx; i++) {
-      pict.line(pp1, q3, pp1, qq1, color);
-      pict.line(pp2, q3, pp2, qq2, color);
-
-      pp1++;
-      pp2--;
-
-      e += 2 * dq;
-      if (e >= 0) {
-        qq1--;
-        qq2++;
-        e -= 2 * dp;
-      }
-    }
-    if (!(dp % 2))
-      pict.line(pp1, q3, pp1, qq1, color);
+  for (int j = 0; j < h; j++)
+    for (int i = 0; i < w; i++)
+      fillInside_(pict, x + i, y + j, color);
 
-  }//end of for
+  // 各HEXの邊の上の畫素は、範圍内の全ての邊を引いて塗る
+  draw(pict, x, y, w, h, color);
 }
 
 
@@ -0,0 +1,414 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_antialias.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファのアンチエイリアス描畫の被覆率の算出
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <cmath>
+#include "imagebuffer.h"
+
+
+namespace {
+
+/// 多角形の被覆率を一度に積算するライン數
+constexpr int BAND_HEIGHT_ = 16;
+
+
+/// 1ライン分の被覆率の區間
+struct CoverageRun_
+{
+  int y;
+  int x;
+  std::vector<std::uint8_t> cov;
+};
+
+
+/// 區間が畫像の範圍内にあれば出力する
+inline void flushRun_(
+  const CoverageRun_& run, int h, const eunomia::implement_::CoverageSink_& sink)
+{
+  if (run.y >= 0 && run.y < h && !run.cov.empty())
+    sink(run.y, run.x, run.cov.data(), (int)run.cov.size());
+}
+
+
+/// 0以上の整數の平方根の切り捨て
+inline long long isqrt_(long long n) noexcept
+{
+  long long r = (long long)std::sqrt((double)n);
+  while (r * r > n)
+    --r;
+  while ((r + 1) * (r + 1) <= n)
+    ++r;
+  return r;
+}
+
+
+/// @brief 多角形の邊
+///
+/// 上端(x0, y0)から下端(x1, y1)への線分。
+/// dirは元の邊が下向きならば1、上向きならば-1。
+struct Segment_
+{
+  double x0, y0, x1, y1;
+  double dir;
+};
+
+
+/// @brief 邊の面積の積算
+///
+/// ラインtop〜top + rows - 1の範圍にある邊の部分が、
+/// その右側の畫素に與へる被覆率の增分をaccに加へる。
+/// accは1ラインあたりstride要素。X座標はあらかじめ0〜stride - 2に收めておく。
+void accumulate_(
+  const Segment_& s, int top, int rows, float* acc, int stride)
+{
+  double ya = std::max(s.y0, (double)top);
+  double yb = std::min(s.y1, (double)(top + rows));
+  if (ya >= yb)
+    return;
+
+  // 丸め誤差で範圍を越えないやう、交點は邊の兩端の間に收める
+  double xmin = std::min(s.x0, s.x1);
+  double xmax = std::max(s.x0, s.x1);
+  double dxdy = (s.x1 - s.x0) / (s.y1 - s.y0);
+  double x = std::clamp(s.x0 + (ya - s.y0) * dxdy, xmin, xmax);
+
+  for (int j = (int)std::floor(ya); j < yb; ++j) {
+    float* line = acc + (j - top) * stride;
+    double dy = std::min((double)(j + 1), yb) - std::max((double)j, ya);
+    double xnext = std::clamp(x + dxdy * dy, xmin, xmax);
+    double d = dy * s.dir;
+
+    double xl = std::min(x, xnext);
+    double xr = std::max(x, xnext);
+    double xlf = std::floor(xl);
+    int xli = (int)xlf;
+    double xrc = std::ceil(xr);
+    int xri = (int)xrc;
+
+    if (xri <= xli + 1) {
+      // 1畫素内に收まる
+      double xm = 0.5 * (x + xnext) - xlf;
+      line[xli] += d - d * xm;
+      line[xli + 1] += d * xm;
+    }
+    else {
+      // 複數の畫素に跨る
+      double sl = 1.0 / (xr - xl);
+      double xlfr = xl - xlf;
+      double a0 = 0.5 * sl * (1.0 - xlfr) * (1.0 - xlfr);
+      double xrfr = xr - xrc + 1.0;
+      double am = 0.5 * sl * xrfr * xrfr;
+
+      line[xli] += d * a0;
+      if (xri == xli + 2)
+        line[xli + 1] += d * (1.0 - a0 - am);
+      else {
+        double a1 = sl * (1.5 - xlfr);
+        line[xli + 1] += d * (a1 - a0);
+        for (int i = xli + 2; i < xri - 1; ++i)
+          line[i] += d * sl;
+        double a2 = a1 + (xri - xli - 3) * sl;
+        line[xri - 1] += d * (1.0 - a2 - am);
+      }
+      line[xri] += d * am;
+    }
+
+    x = xnext;
+  }
+}
+
+
+/// @brief 邊の追加
+///
+/// 邊をX座標0とwidthで分割し、範圍外の部分は境界上に寄せて追加する。
+/// 左側の部分は境界上にあつても右側の被覆率に同じく寄與し、
+/// 右側の部分は範圍内の被覆率に寄與しないので、結果は變はらない。
+void addSegment_(
+  std::vector<Segment_>& segs, double x0, double y0, double x1, double y1,
+  double dir, double width)
+{
+  double cuts[2] = { 0.0, width };
+  double ys[4] = { y0, 0.0, 0.0, y1 };
+  int n = 1;
+  for (double c : cuts)
+    if ((x0 < c && c < x1) || (x1 < c && c < x0))
+      ys[n++] = y0 + (c - x0) * (y1 - y0) / (x1 - x0);
+  ys[n] = y1;
+  if (n == 3 && ys[2] < ys[1])
+    std::swap(ys[1], ys[2]);
+
+  auto xAt = [=](double y) {
+    return std::clamp(x0 + (y - y0) * (x1 - x0) / (y1 - y0), 0.0, width);
+  };
+  for (int i = 0; i < n; ++i)
+    if (ys[i] < ys[i + 1])
+      segs.push_back(Segment_{xAt(ys[i]), ys[i], xAt(ys[i + 1]), ys[i + 1], dir});
+}
+
+
+}// end of NONAME namespace
+
+
+
+
+void
+eunomia::implement_::coverLine_(
+  int x1, int y1, int x2, int y2, int w, int h, const CoverageSink_& sink)
+{
+  int dx = x2 - x1;
+  int dy = y2 - y1;
+
+  if (std::abs(dx) >= std::abs(dy)) {
+    // X方向が主軸: 各列で直線を挾む上下2畫素に配分する
+    if (dx < 0) {
+      std::swap(x1, x2);
+      std::swap(y1, y2);
+      dx = -dx;
+      dy = -dy;
+    }
+    int xb = std::max(x1, 0);
+    int xe = std::min(x2, w - 1);
+    if (xb > xe)
+      return;
+
+    // Y座標は16ビットの固定小數點數で追ふ
+    long long grad = dx ? ((long long)dy << 16) / dx : 0;
+    long long yf = ((long long)y1 << 16) + (xb - x1) * grad;
+
+    // 上の畫素のラインaと下の畫素のラインbの區間を竝行して作る
+    int k = (int)(yf >> 16);
+    CoverageRun_ a{k, xb, {}};
+    CoverageRun_ b{k + 1, xb, {}};
+    for (int x = xb; x <= xe; ++x, yf += grad) {
+      int kk = (int)(yf >> 16);
+      if (kk == k + 1) {
+        flushRun_(a, h, sink);
+        std::swap(a, b);
+        b.y = kk + 1;
+        b.x = x;
+        b.cov.clear();
+      }
+      else if (kk == k - 1) {
+        flushRun_(b, h, sink);
+        std::swap(a, b);
+        a.y = kk;
+        a.x = x;
+        a.cov.clear();
+      }
+      k = kk;
+
+      int f = (int)((yf >> 8) & 0xFF);
+      a.cov.push_back(255 - f);
+      b.cov.push_back(f);
+    }
+    flushRun_(a, h, sink);
+    flushRun_(b, h, sink);
+  }
+  else {
+    // Y方向が主軸: 各ラインで直線を挾む左右2畫素に配分する
+    if (dy < 0) {
+      std::swap(x1, x2);
+      std::swap(y1, y2);
+      dx = -dx;
+      dy = -dy;
+    }
+    int yb = std::max(y1, 0);
+    int ye = std::min(y2, h - 1);
+
+    long long grad = ((long long)dx << 16) / dy;
+    long long xf = ((long long)x1 << 16) + (yb - y1) * grad;
+    for (int y = yb; y <= ye; ++y, xf += grad) {
+      int k = (int)(xf >> 16);
+      int f = (int)((xf >> 8) & 0xFF);
+      std::uint8_t cov[2] = { (std::uint8_t)(255 - f), (std::uint8_t)f };
+
+      int l = std::max(k, 0);
+      int r = std::min(k + 2, w);
+      if (l < r)
+        sink(y, l, cov + (l - k), r - l);
+    }
+  }
+}
+
+
+void
+eunomia::implement_::coverCircle_(
+  int x, int y, int r, bool fill, int w, int h, const CoverageSink_& sink)
+{
+  if (r == 0)
+    return;
+  r = std::abs(r);
+
+  // 被覆率が正となるのは中心からの距離がr + 1未滿の畫素
+  long long outer = (long long)(r + 1) * (r + 1);
+  long long full = (long long)r * r;
+  long long inner = (long long)(r - 1) * (r - 1);
+
+  std::vector<std::uint8_t> cov;
+
+  // 距離の2乘がsとなる畫素の被覆率
+  auto coverage = [=](long long s) -> std::uint8_t {
+    double d = std::sqrt((double)s);
+    double c = fill ? r + 1 - d : 1.0 - std::abs(d - r);
+    return (std::uint8_t)std::clamp((int)(c * 255.0 + 0.5), 0, 255);
+  };
+
+  // 中心からの水平距離d0〜d1の畫素を左右それぞれ出力する
+  auto emit = [&](int j, long long dy2, long long d0, long long d1) {
+    if (d0 > d1)
+      return;
+
+    // 右側
+    long long xb = std::max<long long>(x + d0, 0);
+    long long xe = std::min<long long>(x + d1, w - 1);
+    if (xb <= xe) {
+      cov.clear();
+      for (long long i = xb; i <= xe; ++i) {
+        long long s = (i - x) * (i - x) + dy2;
+        cov.push_back(fill && s <= full ? 255 : coverage(s));
+      }
+      sink(j, (int)xb, cov.data(), (int)cov.size());
+    }
+
+    // 左側(d0 == 0の畫素は右側で出力濟み)
+    xb = std::max<long long>(x - d1, 0);
+    xe = std::min<long long>(x - std::max<long long>(d0, 1), w - 1);
+    if (xb <= xe) {
+      cov.clear();
+      for (long long i = xb; i <= xe; ++i) {
+        long long s = (i - x) * (i - x) + dy2;
+        cov.push_back(fill && s <= full ? 255 : coverage(s));
+      }
+      sink(j, (int)xb, cov.data(), (int)cov.size());
+    }
+  };
+
+  int jb = std::max(y - r, 0);
+  int je = std::min(y + r, h - 1);
+  for (int j = jb; j <= je; ++j) {
+    long long dy2 = (long long)(j - y) * (j - y);
+    if (dy2 >= outer)
+      continue;
+
+    // 水平距離がd1以下の畫素のみ被覆率を持ち得る
+    long long d1 = isqrt_(outer - dy2 - 1);
+
+    if (fill || dy2 > inner)
+      emit(j, dy2, 0, d1);
+    else {
+      // 圓環の内側の穴を除く
+      long long d0 = isqrt_(inner - dy2) + 1;
+      emit(j, dy2, d0, d1);
+    }
+  }
+}
+
+
+void
+eunomia::implement_::coverPolygon_(
+  std::span<const Point> points, FillRule rule, int w, int h,
+  const CoverageSink_& sink)
+{
+  if (points.size() < 3 || w <= 0 || h <= 0)
+    return;
+
+  // 外接矩形を畫像の範圍に切り詰める
+  int xmin = points[0].x, xmax = xmin, ymin = points[0].y, ymax = ymin;
+  for (const auto& p : points) {
+    xmin = std::min(xmin, p.x);
+    xmax = std::max(xmax, p.x);
+    ymin = std::min(ymin, p.y);
+    ymax = std::max(ymax, p.y);
+  }
+  int left = std::max(xmin, 0);
+  int right = std::min(xmax, w);
+  int top = std::max(ymin, 0);
+  int bottom = std::min(ymax, h);
+  if (left >= right || top >= bottom)
+    return;
+
+  // X座標をleftからの相對座標にした邊の表
+  int width = right - left;
+  std::vector<Segment_> segs;
+  segs.reserve(points.size() * 3);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    Point p0 = points[i];
+    Point p1 = points[(i + 1) % points.size()];
+    if (p0.y == p1.y)
+      continue;
+
+    double dir = 1.0;
+    if (p0.y > p1.y) {
+      std::swap(p0, p1);
+      dir = -1.0;
+    }
+    addSegment_(
+      segs, p0.x - left, p0.y, p1.x - left, p1.y, dir, width);
+  }
+
+  // 帶状の範圍毎に積算し、ライン毎に累積和から被覆率を求める
+  int stride = width + 2;
+  std::vector<float> acc(stride * BAND_HEIGHT_);
+  std::vector<std::uint8_t> cov(width);
+
+  for (int band = top; band < bottom; band += BAND_HEIGHT_) {
+    int rows = std::min(BAND_HEIGHT_, bottom - band);
+    std::fill_n(acc.begin(), stride * rows, 0.0f);
+    for (const auto& s : segs)
+      if (s.y1 > band && s.y0 < band + rows)
+        accumulate_(s, band, rows, acc.data(), stride);
+
+    for (int j = 0; j < rows; ++j) {
+      const float* line = acc.data() + j * stride;
+      float sum = 0.0f;
+      for (int i = 0; i < width; ++i) {
+        sum += line[i];
+        float a = std::abs(sum);
+        if (rule == FillRule::EvenOdd) {
+          a = std::fmod(a, 2.0f);
+          if (a > 1.0f)
+            a = 2.0f - a;
+        }
+        else
+          a = std::min(a, 1.0f);
+        cov[i] = (std::uint8_t)(a * 255.0f + 0.5f);
+      }
+      sink(band + j, left, cov.data(), width);
+    }
+  }
+}
+
+
+
+
+//eof
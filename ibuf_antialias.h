@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_antialias.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファクラステンプレートのアンチエイリアス描畫の實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+/* This file is included by "imagebuffer.h". */
+#include <functional>
+#include <vector>
+
+
+namespace eunomia::implement_
+{
+/**
+ * @brief 被覆率の出力先
+ *
+ * sink(y, x, cov, n)の形で呼び出され、ラインyのX座標x〜x + n - 1の畫素の
+ * 被覆率(0〜255)をcov[0]〜cov[n - 1]で受け取る。
+ * 區間は畫像の範圍内に切り詰められてゐるが、被覆率0の畫素を含み得る。
+ */
+using CoverageSink_
+  = std::function<void(int y, int x, const std::uint8_t* cov, int n)>;
+
+
+/// @brief 直線の被覆率の算出(Wuのアルゴリズム)
+///
+/// 畫素(x, y)の中心を座標(x, y)とみなし、
+/// 主軸方向の1畫素毎に直線を挾む2畫素へ距離に應じて被覆率を配分する。
+void coverLine_(
+  int x1, int y1, int x2, int y2, int w, int h, const CoverageSink_& sink);
+
+/// @brief 圓の被覆率の算出
+///
+/// 畫素の中心から圓周までの距離で被覆率を近似する。
+/// 塗り潰す場合は半徑r + 0.5の圓板、さもなくば幅1の圓環の被覆率となる。
+void coverCircle_(
+  int x, int y, int r, bool fill, int w, int h, const CoverageSink_& sink);
+
+/// @brief 多角形の被覆率の算出
+///
+/// 各畫素の正方形と多角形の重なる面積を邊毎に符號附きで積算して求める。
+/// 頂點(x, y)は畫素(x, y)の左上の角に當たる。
+void coverPolygon_(
+  std::span<const Point> points, FillRule rule, int w, int h,
+  const CoverageSink_& sink);
+
+
+}//end of namespace eunomia::implement_
+
+
+
+
+template<class C_> template<class CSrc, class Copier, class Cover>
+inline
+void
+eunomia::ImageBuffer<C_>::blendCoverage_(
+  const CSrc& color, Copier& copier, Cover cover)
+{
+  // 被覆率に應じて不透明度を下げた色を竝べ、區間毎にcopierへ渡す
+  std::vector<CSrc> row;
+  int left = w_, right = 0, top = h_, bottom = 0;
+
+  auto sink = [&](int y, int x, const std::uint8_t* cov, int n) {
+    if (row.size() < static_cast<std::size_t>(n))
+      row.resize(n, color);
+
+    C_* line = lineBuffer(y) + x;
+    int i = 0;
+    while (i < n) {
+      // 被覆率0の畫素は飛ばす
+      while (i < n && cov[i] == 0)
+        ++i;
+      int b = i;
+      for (; i < n && cov[i] != 0; ++i) {
+        row[i] = color;
+        row[i].alpha = (color.alpha * cov[i] + 127) / 255;
+      }
+      if (b == i)
+        break;
+
+      implement_::copyRow_(copier, row.data() + b, line + b, i - b);
+      left = std::min(left, x + b);
+      right = std::max(right, x + i);
+      top = std::min(top, y);
+      bottom = std::max(bottom, y + 1);
+    }
+  };
+
+  cover(w_, h_, implement_::CoverageSink_(std::ref(sink)));
+  damaged_(left, top, right, bottom);
+}
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::lineAA(
+  int x1, int y1, int x2, int y2, const CSrc& color, Copier copier)
+{
+  blendCoverage_(
+    color, copier,
+    [=](int w, int h, const implement_::CoverageSink_& sink) {
+      implement_::coverLine_(x1, y1, x2, y2, w, h, sink);
+    });
+}
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::circleAA(
+  int x, int y, int r, const CSrc& color, Copier copier, bool fill)
+{
+  blendCoverage_(
+    color, copier,
+    [=](int w, int h, const implement_::CoverageSink_& sink) {
+      implement_::coverCircle_(x, y, r, fill, w, h, sink);
+    });
+}
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::fillPolygonAA(
+  std::span<const Point> points, const CSrc& color, Copier copier,
+  FillRule rule)
+{
+  blendCoverage_(
+    color, copier,
+    [=](int w, int h, const implement_::CoverageSink_& sink) {
+      implement_::coverPolygon_(points, rule, w, h, sink);
+    });
+}
+
+
+
+
+//eof
@@ -30,6 +30,7 @@
  * @brief 畫像バッファ轉送のクリッピングの實裝
  *
  * @date 2021.4.22 作成
+ * @date 2026.10.17 座標の計算を64bitで行ふやうに變更
  *
  */
 #include "imagebuffer.h"
@@ -39,47 +40,51 @@ eunomia::implement_::Clipper_::Clipper_(
   int dstx, int dsty, int dstw, int dsth, const std::optional<Rect>& cliprect)
   : flag_(false)
 {
+  // 座標と幅、高さの和がintを溢れないやう、long longで計算する。
+  using Coord = long long;
+
   // 轉送元のクリッピング
-  int sleft = std::max(srcx, 0);
-  int sright = std::min(srcx + bltw, srcw);
-  int stop = std::max(srcy, 0);
-  int sbottom = std::min(srcy + blth, srch);
+  Coord sleft = std::max<Coord>(srcx, 0);
+  Coord sright = std::min<Coord>(Coord(srcx) + bltw, srcw);
+  Coord stop = std::max<Coord>(srcy, 0);
+  Coord sbottom = std::min<Coord>(Coord(srcy) + blth, srch);
 
   if (sleft > sright || stop > sbottom)
     return;
 
   // 轉送元のクリッピングを受けて、轉送先座標を(必要なら)右下方向にずらす。
-  dstx += sleft - srcx;
-  dsty += stop - srcy;
+  Coord dstx2 = dstx + (sleft - srcx);
+  Coord dsty2 = dsty + (stop - srcy);
 
   // 轉送元のクリッピングを受けて、轉送する幅と高さを更新する。
-  bltw = sright - sleft;
-  blth = sbottom - stop;
+  Coord bltw2 = sright - sleft;
+  Coord blth2 = sbottom - stop;
 
   // 轉送先のクリッピング
-  int dleft, dtop, dright, dbottom;
+  Coord dleft, dtop, dright, dbottom;
   if (cliprect) {
-    dleft = std::max({dstx, cliprect->left, 0});
-    dtop = std::max({dsty, cliprect->top, 0});
-    dright = std::min({dstx + bltw, dstw, cliprect->right});
-    dbottom = std::min({dsty + blth, dsth, cliprect->bottom});
+    dleft = std::max<Coord>({dstx2, cliprect->left, 0});
+    dtop = std::max<Coord>({dsty2, cliprect->top, 0});
+    dright = std::min<Coord>({dstx2 + bltw2, dstw, cliprect->right});
+    dbottom = std::min<Coord>({dsty2 + blth2, dsth, cliprect->bottom});
   } else {
-    dleft = std::max(dstx, 0);
-    dtop = std::max(dsty, 0);
-    dright = std::min(dstx + bltw, dstw);
-    dbottom = std::min(dsty + blth, dsth);
+    dleft = std::max<Coord>(dstx2, 0);
+    dtop = std::max<Coord>(dsty2, 0);
+    dright = std::min<Coord>(dstx2 + bltw2, dstw);
+    dbottom = std::min<Coord>(dsty2 + blth2, dsth);
   }
 
   if (dleft > dright || dtop > dbottom)
     return;
 
-  dx = dleft;
-  dy = dtop;
-  w = dright - dleft;
-  h = dbottom - dtop;
+  // 以下の値は全て轉送元あるいは轉送先の畫像の範圍に收まる。
+  dx = static_cast<int>(dleft);
+  dy = static_cast<int>(dtop);
+  w = static_cast<int>(dright - dleft);
+  h = static_cast<int>(dbottom - dtop);
 
-  sx = sleft + dleft - dstx;
-  sy = stop + dtop - dsty;
+  sx = static_cast<int>(sleft + dleft - dstx2);
+  sy = static_cast<int>(stop + dtop - dsty2);
 
   flag_ = true;
 }
@@ -30,6 +30,10 @@
  * @brief 畫像バッファクラステンプレートのblt系メンバ函數の實裝
  *
  * @date 2021.4.22 作成
+ * @date 2026.10.17 RowCopierを1ライン毎に呼び出すやうに變更
+ * @date 2026.10.17 PlainCopierによる轉送をmemmove()で行ふやうに變更
+ * @date 2026.10.17 竝列版のblt()を追加
+ * @date 2026.10.17 變更範圍を記録するやうに變更
  *
  */
 /* This file is included by "imagebuffer.h". */
@@ -73,6 +77,57 @@ public:
 };
 
 
+/**
+ * @brief 1ライン分の轉寫
+ *
+ * copierがPlainCopierを滿たす場合はmemmove()で轉送し、
+ * RowCopierを滿たす場合は一度だけ呼び出し、
+ * さうでなければピクセル毎に呼び出す。
+ */
+template<class CSrc, class C_, class Copier>
+inline void copyRow_(Copier& copier, const CSrc* sp, C_* dp, int n)
+{
+  if constexpr (PlainCopier<Copier, CSrc, C_>)
+    std::memmove(dp, sp, sizeof(C_) * n);
+  else if constexpr (RowCopier<Copier, CSrc, C_>)
+    copier(sp, dp, n);
+  else
+    for (int i = 0; i < n; ++i)
+      copier(sp[i], dp[i]);
+}
+
+
+/**
+ * @brief クリッピング後の[begin, end)ラインの轉送
+ *
+ * beginとendはクリッピング後の轉送範圍の上端からのライン數。
+ */
+template<class CSrc, class C_, class Copier>
+void bltRows_(
+  const ImageBuffer<CSrc>& src, ImageBuffer<C_>& dst, const Clipper_& clipper,
+  int begin, int end, Copier& copier)
+{
+  auto dl = dst.buffer() + dst.pitch() * (clipper.dy + begin);
+  auto sl = src.buffer() + src.pitch() * (clipper.sy + begin);
+
+  // 行間に隙閒の無い連續領域ならば一度に轉送する
+  if constexpr (PlainCopier<Copier, CSrc, C_>) {
+    const auto rowbytes = static_cast<std::ptrdiff_t>(sizeof(C_)) * clipper.w;
+    if (dst.pitch() == rowbytes && src.pitch() == rowbytes) {
+      std::memmove(dl, sl, static_cast<std::size_t>(rowbytes) * (end - begin));
+      return;
+    }
+  }
+
+  for (int j = begin; j < end; ++j, dl += dst.pitch(), sl += src.pitch())
+    copyRow_(
+      copier,
+      reinterpret_cast<const CSrc*>(sl) + clipper.sx,
+      reinterpret_cast<C_*>(dl) + clipper.dx,
+      clipper.w);
+}
+
+
 }//end of namespace eunomia::implement_
 
 
@@ -92,14 +147,37 @@ eunomia::ImageBuffer<C_>::blt(
       dx, dy, width(), height(), cliprect);
 
   if (clipper) {
-    auto dl = buffer() + pitch() * clipper.dy;
-    auto sl = src.buffer() + src.pitch() * clipper.sy;
-
-    for (int j = 0; j < clipper.h; ++j, dl += pitch(), sl += src.pitch())
-      for (int i = 0; i < clipper.w; ++i)
-        copier(
-          reinterpret_cast<const CSrc*>(sl)[clipper.sx + i],
-          reinterpret_cast<C_*>(dl)[clipper.dx + i]);
+    damaged_(
+      clipper.dx, clipper.dy, clipper.dx + clipper.w, clipper.dy + clipper.h);
+    implement_::bltRows_(src, *this, clipper, 0, clipper.h, copier);
+  }
+}
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::blt(
+  int threads,
+  const eunomia::ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+  int dx, int dy, const std::optional<eunomia::Rect>& cliprect,
+  Copier copier)
+{
+  implement_::Clipper_
+    clipper(
+      sx, sy, src.width(), src.height(), w, h,
+      dx, dy, width(), height(), cliprect);
+
+  if (clipper) {
+    damaged_(
+      clipper.dx, clipper.dy, clipper.dx + clipper.w, clipper.dy + clipper.h);
+    implement_::parallelRows_(
+      clipper.h, implement_::threadsForArea_(threads, clipper.w, clipper.h),
+      [this, &src, &clipper, &copier](int begin, int end) {
+        // copierはスレッド毎に複製して用ゐる
+        Copier c = copier;
+        implement_::bltRows_(src, *this, clipper, begin, end, c);
+      });
   }
 }
 
@@ -32,10 +32,14 @@
  * @date 2016.2.26 ellipse()内の不使用變數の宣言を削除
  * @date 2021.4.22 LIBPOLYMNIAからLIBEUNOMIAに移植
  * @date 2021.6.10 paintFill()内の不使用變數の宣言を削除
+ * @date 2026.10.17 變更範圍を記録するやうに變更
+ * @date 2026.10.17 ellipse()の弧6が右端を越えて書き込む誤りを修正
+ * @date 2026.10.17 楕圓の塗り潰しを1ライン1區間で行ふやうに變更
  *
  */
 /* This file is included by "imagebuffer.h". */
 #include <stack>
+#include <vector>
 #include <cstdlib>
 #include <algorithm>
 
@@ -44,6 +48,8 @@
 template<class C_>
 inline void eunomia::ImageBuffer<C_>::clear(const C_& color)
 {
+  damaged_(0, 0, w_, h_);
+
   std::uint8_t* lp = buffer();
   for (int j = 0; j < height(); ++j, lp += pitch())
     std::fill_n(reinterpret_cast<C_*>(lp), width(), color);
@@ -63,6 +69,10 @@ eunomia::ImageBuffer<C_>::line(int x1, int y1, int x2, int y2, const C_& color)
       || (y1 < 0 && y2 < 0) || (y1 >= h_ && y2 >= h_))
     return;
 
+  damaged_(
+    std::max(std::min(x1, x2), 0), std::max(std::min(y1, y2), 0),
+    std::min(std::max(x1, x2) + 1, w_), std::min(std::max(y1, y2) + 1, h_));
+
   int dx, dy, sx, sy; // 差分と正負
 
   dx = x2 - x1;
@@ -216,6 +226,8 @@ eunomia::ImageBuffer<C_>::box(
   int yy1 = std::max(top, 0);
   int yy2 = std::min(bottom, h_ - 1);
 
+  damaged_(xx1, yy1, xx2 + 1, yy2 + 1);
+
   if (fill) { // 塗り潰し
     std::uint8_t* lp = buf_ + pitch_ * yy1;
     for (int j = yy1; j <= yy2; ++j, lp += pitch_)
@@ -252,12 +264,68 @@ eunomia::ImageBuffer<C_>::box(
  *   5       6       <-- コメント中で用いた番號
  *     7   8
  */
+namespace eunomia::implement_
+{
+/// @brief 楕圓の各ラインの半幅の算出
+///
+/// 中心からdyだけ離れたラインで塗り潰す區間の半幅をhw[dy]に格納する。
+/// 輪郭の描畫と同じ點列から求めるので、塗り潰した結果は輪郭と一致する。
+/// 該當する點の無いラインは-1とする。
+/// @param a 水平方向の半徑(正)
+/// @param b 垂直方向の半徑(正)
+/// @param hw 結果を格納する配列
+inline void ellipseHalfWidths_(int a, int b, std::vector<int>& hw)
+{
+  hw.assign(b + 1, -1);
+
+  int p = 0;  // 半徑の短い方向の差分
+  int q = std::max(a, b);  // 半徑の長い方向の差分
+  int e = 2 - 3 * q;  // 判定用
+
+  while (p <= q) {
+    // 弧1, 2, 7, 8と弧3, 4, 5, 6の中心との差分
+    int dx1, dy1, dx2, dy2;
+    if (a < b) {
+      dx1 = p * a / b;
+      dy1 = q;
+      dx2 = q * a / b;
+      dy2 = p;
+    }
+    else {
+      dx1 = p;
+      dy1 = q * b / a;
+      dx2 = q;
+      dy2 = p * b / a;
+    }
+    hw[dy1] = std::max(hw[dy1], dx1);
+    hw[dy2] = std::max(hw[dy2], dx2);
+
+    if (e < 0)
+      e += p * 4 + 6;
+    else {
+      e += (p - q) * 4 + 10;
+      q--;
+    }
+    p++;
+  }
+}
+
+
+}//end of namespace eunomia::implement_
+
+
 template<class C_>
 inline
 void
 eunomia::ImageBuffer<C_>::ellipse(
   int x, int y, int a, int b, const C_& color, bool fill)
 {
+  if (fill) {
+    scanEllipse_(
+      x, y, a, b, [&color](C_* d, int n) { std::fill_n(d, n, color); });
+    return;
+  }
+
   if (a == 0 || b == 0)
     return;
 
@@ -265,6 +333,10 @@ eunomia::ImageBuffer<C_>::ellipse(
   a = std::abs(a);
   b = std::abs(b);
 
+  damaged_(
+    std::max(x - a, 0), std::max(y - b, 0),
+    std::min(x + a + 1, w_), std::min(y + b + 1, h_));
+
   int p = 0;  // 半徑の短い方向の差分
   int q; // 半徑の長い方向の差分
   int e; // 判定用
@@ -302,28 +374,17 @@ eunomia::ImageBuffer<C_>::ellipse(
     if (x - dx1 < w_  &&  x + dx1 >= 0  &&  y - dy1 < h_  && y + dy1 >= 0) {
       // ↑まづは完全に畫像領域外でないことを確かめる
 
-      if (fill) {
-        int left = std::max(x - dx1, 0);
-        int right = std::min(x + dx1, w_ - 1);
-
-        if (y - dy1 >= 0) // 1<=>2
-          std::fill_n(lineBuffer(y - dy1) + left, right - left + 1, color);
-        if (y + dy1 < h_) // 7<=>8
-          std::fill_n(lineBuffer(y + dy1) + left, right - left + 1, color);
+      if (y - dy1 >= 0) {
+        if (x - dx1 >= 0)
+          pixel(x - dx1, y - dy1) = color; // 1
+        if (x + dx1 < w_)
+          pixel(x + dx1, y - dy1) = color; // 2
       }
-      else {
-        if (y - dy1 >= 0) {
-          if (x - dx1 >= 0)
-            pixel(x - dx1, y - dy1) = color; // 1
-          if (x + dx1 < w_)
-            pixel(x + dx1, y - dy1) = color; // 2
-        }
-        if (y + dy1 < h_) {
-          if (x - dx1 >= 0)
-            pixel(x - dx1, y + dy1) = color; // 7
-          if (x + dx1 < w_)
-            pixel(x + dx1, y + dy1) = color; // 8
-        }
+      if (y + dy1 < h_) {
+        if (x - dx1 >= 0)
+          pixel(x - dx1, y + dy1) = color; // 7
+        if (x + dx1 < w_)
+          pixel(x + dx1, y + dy1) = color; // 8
       }
     }
 
@@ -331,28 +392,17 @@ eunomia::ImageBuffer<C_>::ellipse(
     if (x - dx2 < w_  &&  x + dx2 >= 0  &&  y - dy2 < h_  &&  y + dy2 >= 0) {
       // ↑まづは完全に畫像領域外でないことを確かめる
 
-      if (fill) {
-        int left = std::max(x - dx2, 0);
-        int right = std::min(x + dx2, w_ - 1);
-
-        if (y - dy2 >= 0) // 3<=>4
-          std::fill_n(lineBuffer(y - dy2) + left, right - left + 1, color);
-        if (y + dy2 < h_) // 5<=>6
-          std::fill_n(lineBuffer(y + dy2) + left, right - left + 1, color);
+      if (y - dy2 >= 0) {
+        if (x - dx2 >= 0)
+          pixel(x - dx2, y - dy2) = color; // 3
+        if (x + dx2 < w_)
+          pixel(x + dx2, y - dy2) = color; // 4
       }
-      else {
-        if (y - dy2 >= 0) {
-          if (x - dx2 >= 0)
-            pixel(x - dx2, y - dy2) = color; // 3
-          if (x + dx2 < w_)
-            pixel(x + dx2, y - dy2) = color; // 4
-        }
-        if (y + dy2 < h_) {
-          if (x - dx2 >= 0)
-            pixel(x - dx2, y + dy2) = color; // 5
-          if (x + dx1 < w_)
-            pixel(x + dx2, y + dy2) = color; // 6
-        }
+      if (y + dy2 < h_) {
+        if (x - dx2 >= 0)
+          pixel(x - dx2, y + dy2) = color; // 5
+        if (x + dx2 < w_)
+          pixel(x + dx2, y + dy2) = color; // 6
       }
     }
 
@@ -368,6 +418,71 @@ eunomia::ImageBuffer<C_>::ellipse(
 }
 
 
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::fillEllipse(
+  int x, int y, int a, int b, const CSrc& color, Copier copier)
+{
+  // 區間毎にcopierを呼べるやう、最長の區間分の色を竝べておく
+  std::vector<CSrc> row(
+    std::max(std::min(2 * (long long)std::abs(a) + 1, (long long)w_), 0LL),
+    color);
+  scanEllipse_(
+    x, y, a, b,
+    [&row, &copier](C_* d, int n) {
+      implement_::copyRow_(copier, row.data(), d, n);
+    });
+}
+
+
+// 塗り潰す楕圓の各ラインの區間をfunc(先頭, 畫素數)で處理する
+template<class C_> template<class Func>
+inline
+void
+eunomia::ImageBuffer<C_>::scanEllipse_(
+  int x, int y, int a, int b, Func func)
+{
+  if (a == 0 || b == 0)
+    return;
+
+  a = std::abs(a);
+  b = std::abs(b);
+
+  // 完全に畫像領域外ならば何もしない
+  if (x - a >= w_ || x + a < 0 || y - b >= h_ || y + b < 0)
+    return;
+
+  std::vector<int> hw;
+  implement_::ellipseHalfWidths_(a, b, hw);
+
+  int left = w_, right = 0, top = h_, bottom = 0;
+
+  // 上から順に1ラインにつき1區間を塗る
+  int jb = std::max(y - b, 0);
+  int je = std::min(y + b + 1, h_);
+  for (int j = jb; j < je; ++j) {
+    int d = hw[std::abs(j - y)];
+    if (d < 0)
+      continue;
+
+    int l = std::max(x - d, 0);
+    int r = std::min(x + d + 1, w_);
+    if (l >= r)
+      continue;
+
+    func(lineBuffer(j) + l, r - l);
+
+    left = std::min(left, l);
+    right = std::max(right, r);
+    top = std::min(top, j);
+    bottom = j + 1;
+  }
+
+  damaged_(left, top, right, bottom);
+}
+
+
 /*================================================
  *  所謂塗り潰し
  */
@@ -384,6 +499,9 @@ inline void eunomia::ImageBuffer<C_>::paintFill(int x, int y, const C_& color)
   std::stack<Point> pstack;
   pstack.push(Point(x, y));
 
+  // 塗つた範圍
+  int minx = x, maxx = x, miny = y, maxy = y;
+
   while (!pstack.empty()) {
     Point p = pstack.top();
     pstack.pop();
@@ -416,6 +534,8 @@ inline void eunomia::ImageBuffer<C_>::paintFill(int x, int y, const C_& color)
 
     // 現在の地點を塗る
     pixel(xx, yy) = color;
+    miny = std::min(miny, yy);
+    maxy = std::max(maxy, yy);
 
     C_* lb = lineBuffer(yy);
     C_* lbu = lineBuffer(yy - 1);
@@ -443,6 +563,7 @@ inline void eunomia::ImageBuffer<C_>::paintFill(int x, int y, const C_& color)
       }
 
       lb[l] = color;
+      minx = std::min(minx, l);
     }
 
     // 右に進む
@@ -467,8 +588,11 @@ inline void eunomia::ImageBuffer<C_>::paintFill(int x, int y, const C_& color)
       }
 
       lb[r] = color;
+      maxx = std::max(maxx, r);
     }
   }
+
+  damaged_(minx, miny, maxx + 1, maxy + 1);
 }
 
 
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_polygon.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの多角形の走査線變換の實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include "imagebuffer.h"
+
+
+namespace {
+
+// 整數の除算の切り上げ(bは正)
+inline long long ceilDiv_(long long a, long long b) noexcept
+{
+  return a >= 0 ? (a + b - 1) / b : -((-a) / b);
+}
+
+
+}// end of NONAME namespace
+
+
+eunomia::implement_::PolygonScanner_::PolygonScanner_(
+  std::span<const Point> points, FillRule rule, int w, int h)
+  : top(0), bottom(0), rule_(rule), w_(w), next_(0)
+{
+  if (points.size() < 3 || w <= 0 || h <= 0)
+    return;
+
+  // 邊表を作る。水平な邊はどのラインの中心とも交はらないので除く。
+  edges_.reserve(points.size());
+  int ymin = h, ymax = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    Point p0 = points[i];
+    Point p1 = points[(i + 1) % points.size()];
+    if (p0.y == p1.y)
+      continue;
+
+    int dir = 1;
+    if (p0.y > p1.y) {
+      std::swap(p0, p1);
+      dir = -1;
+    }
+
+    // ラインyの中心y + 0.5での交點のX座標は
+    // (2 * dy * x0 + (2 * (y - y0) + 1) * dx) / (2 * dy)
+    long long dx = p1.x - p0.x;
+    long long dy = p1.y - p0.y;
+    edges_.push_back(Edge_{p0.y, p1.y, 2 * dy * p0.x + dx, 2 * dy, 2 * dx, dir});
+
+    ymin = std::min(ymin, p0.y);
+    ymax = std::max(ymax, p1.y);
+  }
+
+  top = std::max(ymin, 0);
+  bottom = std::min(ymax, h);
+  if (top >= bottom)
+    return;
+
+  std::sort(
+    edges_.begin(), edges_.end(),
+    [](const Edge_& a, const Edge_& b) { return a.ytop < b.ytop; });
+
+  // 最初のラインより上から始まる邊を活性化する
+  active_.reserve(edges_.size());
+  crossings_.reserve(edges_.size());
+  for (; next_ < edges_.size() && edges_[next_].ytop <= top; ++next_)
+    if (edges_[next_].ybottom > top)
+      activate_(edges_[next_], top);
+}
+
+
+void
+eunomia::implement_::PolygonScanner_::activate_(const Edge_& e, int y)
+{
+  Edge_ a = e;
+  a.num += (long long)(y - e.ytop) * e.step;
+  active_.push_back(a);
+}
+
+
+void
+eunomia::implement_::PolygonScanner_::scan(int y, std::vector<Span>& spans)
+{
+  spans.clear();
+
+  // 終はつた邊を除き、このラインから始まる邊を加へる
+  std::erase_if(active_, [y](const Edge_& e) { return e.ybottom <= y; });
+  for (; next_ < edges_.size() && edges_[next_].ytop <= y; ++next_)
+    activate_(edges_[next_], y);
+
+  // 交點x = num / denの右にある最初の畫素、
+  // 即ち中心がx以上となる最初の畫素 ceil(x - 0.5) を求める
+  crossings_.clear();
+  for (auto& e : active_) {
+    crossings_.push_back(
+      Crossing_{(int)ceilDiv_(2 * e.num - e.den, 2 * e.den), e.dir});
+    e.num += e.step;
+  }
+  std::sort(
+    crossings_.begin(), crossings_.end(),
+    [](const Crossing_& a, const Crossing_& b) { return a.x < b.x; });
+
+  auto push = [this, &spans](int l, int r) {
+    l = std::max(l, 0);
+    r = std::min(r, w_);
+    if (l < r)
+      spans.push_back(Span{l, r});
+  };
+
+  if (rule_ == FillRule::EvenOdd) {
+    for (std::size_t i = 0; i + 1 < crossings_.size(); i += 2)
+      push(crossings_[i].x, crossings_[i + 1].x);
+  }
+  else {
+    int winding = 0;
+    int left = 0;
+    for (const auto& c : crossings_) {
+      int prev = winding;
+      winding += c.dir;
+      if (prev == 0 && winding != 0)
+        left = c.x;
+      else if (prev != 0 && winding == 0)
+        push(left, c.x);
+    }
+  }
+}
+
+
+
+
+//eof
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_polygon.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファクラステンプレートのfillPolygon()の實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+/* This file is included by "imagebuffer.h". */
+
+
+namespace eunomia::implement_
+{
+/**
+ * @brief 多角形の走査線變換處理クラス
+ *
+ * 邊を上端のY座標順に竝べた邊表と、現在のラインに掛かる邊の表
+ * (活性邊表)を用ゐて、ライン毎に多角形の内側の區間を求める。
+ * ラインyの畫素の中心(x + 0.5, y + 0.5)が多角形の内側にある畫素を塗る。
+ * 邊とラインの交點は整數の增分で辿るので、誤差は生じない。
+ * 頂點の座標の絶對値は2^28未滿でなければならない。
+ */
+class PolygonScanner_
+{
+public:
+  /// @brief 1ライン中の塗り潰す區間
+  struct Span
+  {
+    int left;   ///< 左端のX座標
+    int right;  ///< 右端のX座標(範圍に含まない)
+  };
+
+  int top;     ///< 塗り潰す最初のライン
+  int bottom;  ///< 塗り潰す最後のラインの次
+
+private:
+  /// @brief 邊
+  ///
+  /// 交點のX座標はnum / denで表す。
+  struct Edge_
+  {
+    int ytop;       ///< 上端のY座標
+    int ybottom;    ///< 下端のY座標(範圍に含まない)
+    long long num;  ///< 現在のラインの中心での交點のX座標の分子
+    long long den;  ///< 交點のX座標の分母(2 * 高さ)
+    long long step; ///< 1ラインあたりのnumの增分
+    int dir;        ///< 下向きの邊ならば1、上向きならば-1
+  };
+
+  /// @brief 交點
+  struct Crossing_
+  {
+    int x;    ///< 交點の右にある最初の畫素のX座標
+    int dir;  ///< 邊の向き
+  };
+
+  FillRule rule_;  ///< 内側の判定規則
+  int w_;          ///< 畫像の幅
+  std::vector<Edge_> edges_;   ///< 邊表
+  std::size_t next_;           ///< 次に活性化する邊表の位置
+  std::vector<Edge_> active_;  ///< 活性邊表
+  std::vector<Crossing_> crossings_;  ///< 現在のラインの交點
+
+  void activate_(const Edge_& e, int y);
+
+public:
+  /// @brief 構築子
+  ///
+  /// @param points 頂點。最後の頂點と最初の頂點も邊で結ぶ。
+  /// @param rule 内側の判定規則
+  /// @param w 畫像の幅
+  /// @param h 畫像の高さ
+  PolygonScanner_(
+    std::span<const Point> points, FillRule rule, int w, int h);
+
+  explicit operator bool() const noexcept { return top < bottom; }
+
+  /// @brief ラインの走査
+  ///
+  /// ラインyの塗り潰す區間を、畫像の幅に切り詰めてspansに格納する。
+  /// yはtopからbottom - 1まで順に與へなければならない。
+  void scan(int y, std::vector<Span>& spans);
+};
+
+
+}//end of namespace eunomia::implement_
+
+
+
+
+template<class C_> template<class Func>
+inline
+void
+eunomia::ImageBuffer<C_>::scanPolygon_(
+  std::span<const Point> points, FillRule rule, Func func)
+{
+  using implement_::PolygonScanner_;
+
+  PolygonScanner_ scanner(points, rule, w_, h_);
+  if (!scanner)
+    return;
+
+  std::vector<PolygonScanner_::Span> spans;
+  int left = w_, right = 0, top = scanner.bottom, bottom = scanner.top;
+
+  for (int y = scanner.top; y < scanner.bottom; ++y) {
+    scanner.scan(y, spans);
+    if (spans.empty())
+      continue;
+
+    left = std::min(left, spans.front().left);
+    right = std::max(right, spans.back().right);
+    top = std::min(top, y);
+    bottom = y + 1;
+
+    C_* line = lineBuffer(y);
+    for (const auto& s : spans)
+      func(line + s.left, s.right - s.left);
+  }
+
+  damaged_(left, top, right, bottom);
+}
+
+
+template<class C_>
+inline
+void
+eunomia::ImageBuffer<C_>::fillPolygon(
+  std::span<const Point> points, const C_& color, FillRule rule)
+{
+  scanPolygon_(
+    points, rule, [&color](C_* d, int n) { std::fill_n(d, n, color); });
+}
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::fillPolygon(
+  std::span<const Point> points, const CSrc& color, Copier copier,
+  FillRule rule)
+{
+  // 區間毎にcopierを呼べるやう、1ライン分の色を竝べておく
+  std::vector<CSrc> row(w_, color);
+  scanPolygon_(
+    points, rule,
+    [&row, &copier](C_* d, int n) {
+      implement_::copyRow_(copier, row.data(), d, n);
+    });
+}
+
+
+
+
+//eof
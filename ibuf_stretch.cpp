@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_stretch.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの擴大縮小を伴ふ轉送のクリッピングの實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include "imagebuffer.h"
+
+
+namespace {
+
+using Coord = long long;
+using eunomia::implement_::StretchClipper_;
+
+
+// 正の除數による切り上げ除算
+inline Coord ceilDiv_(Coord a, Coord b) noexcept
+{
+  return a >= 0 ? (a + b - 1) / b : -(-a / b);
+}
+
+
+// 一方向のクリッピングの結果
+struct Axis_
+{
+  int d;        // 轉送先の開始位置
+  int n;        // 轉送先の畫素數
+  Coord u0;     // 轉送先の開始位置の畫素の中心に對應する轉送元の座標
+  Coord du;     // 增分
+  int slo, shi; // 參照してよい轉送元の範圍
+};
+
+
+/*
+ * @brief 一方向のクリッピング
+ *
+ * 轉送元の[s0, s1)を轉送先の[d0, d1)に對應させ、
+ * 轉送先のi番目の畫素の中心に轉送元の座標
+ * s0 + (i + 1/2) * (s1 - s0) / (d1 - d0) を對應させる。
+ * この座標の整數部が轉送元の[max(s0, 0), min(s1, srcsize))に收まり、
+ * かつ轉送先の[dlo, dhi)に收まる畫素の範圍を求める。
+ * @return 範圍が空でなければtrue
+ */
+bool clipAxis_(
+  int s0, int s1, int srcsize, int d0, int d1, Coord dlo, Coord dhi,
+  Axis_& res) noexcept
+{
+  Coord sw = Coord(s1) - s0;
+  Coord dw = Coord(d1) - d0;
+  // 固定小數點の計算が溢れないやう、幅はintで表せる範圍に限る
+  constexpr Coord LIMIT = Coord(1) << 31;
+  if (sw <= 0 || dw <= 0 || sw >= LIMIT || dw >= LIMIT)
+    return false;
+
+  res.slo = std::max(s0, 0);
+  res.shi = std::min(s1, srcsize);
+  if (res.slo >= res.shi)
+    return false;
+
+  res.du = sw * StretchClipper_::ONE / dw;
+  // 轉送先のi番目の畫素の中心は base + i * du に對應する
+  Coord base = s0 * StretchClipper_::ONE + res.du / 2;
+
+  // 轉送元の範圍に收まる i の範圍 [ilo, ihi)
+  Coord ilo = ceilDiv_(res.slo * StretchClipper_::ONE - base, res.du);
+  Coord ihi = ceilDiv_(res.shi * StretchClipper_::ONE - base, res.du);
+
+  Coord lo = std::max({d0 + std::max<Coord>(ilo, 0), dlo});
+  Coord hi = std::min({d0 + std::min(ihi, dw), dhi});
+  if (lo >= hi)
+    return false;
+
+  res.d = static_cast<int>(lo);
+  res.n = static_cast<int>(hi - lo);
+  res.u0 = base + (lo - d0) * res.du;
+  return true;
+}
+
+
+}// end of NONAME namespace
+
+
+eunomia::implement_::StretchClipper_::StretchClipper_(
+  const Rect& srcrect, int srcw, int srch,
+  const Rect& dstrect, int dstw, int dsth,
+  const std::optional<Rect>& cliprect)
+  : flag_(false)
+{
+  Coord xlo = 0, ylo = 0, xhi = dstw, yhi = dsth;
+  if (cliprect) {
+    xlo = std::max<Coord>(xlo, cliprect->left);
+    ylo = std::max<Coord>(ylo, cliprect->top);
+    xhi = std::min<Coord>(xhi, cliprect->right);
+    yhi = std::min<Coord>(yhi, cliprect->bottom);
+  }
+
+  Axis_ x, y;
+  if (
+    !clipAxis_(
+      srcrect.left, srcrect.right, srcw, dstrect.left, dstrect.right,
+      xlo, xhi, x)
+    || !clipAxis_(
+      srcrect.top, srcrect.bottom, srch, dstrect.top, dstrect.bottom,
+      ylo, yhi, y))
+    return;
+
+  dx = x.d;
+  dy = y.d;
+  w = x.n;
+  h = y.n;
+  u0 = x.u0;
+  v0 = y.u0;
+  du = x.du;
+  dv = y.du;
+  sleft = x.slo;
+  sright = x.shi;
+  stop = y.slo;
+  sbottom = y.shi;
+
+  flag_ = true;
+}
+
+
+//eof
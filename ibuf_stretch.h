@@ -0,0 +1,260 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_stretch.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファクラステンプレートのstretchBlt()の實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+/* This file is included by "imagebuffer.h". */
+
+
+namespace eunomia::implement_
+{
+/**
+ * @brief 擴大縮小を伴ふ轉送のクリッピング處理クラス
+ *
+ * 轉送元の座標は32bitの小數部を持つ固定小數點數で表す。
+ */
+class StretchClipper_
+{
+public:
+  static constexpr int FRAC_BITS = 32;
+  static constexpr long long ONE = 1LL << FRAC_BITS;
+
+  int dx, dy;  ///< 轉送先の左上の座標
+  int w, h;    ///< 轉送先の幅と高さ
+  long long u0, v0;  ///< (dx, dy)の畫素の中心に對應する轉送元の座標
+  long long du, dv;  ///< 轉送先の1畫素あたりの轉送元の座標の增分
+  int sleft, stop, sright, sbottom;  ///< 參照してよい轉送元の範圍
+
+private:
+  bool flag_;
+
+public:
+  /// @brief 構築子
+  ///
+  /// @param srcrect 轉送元の範圍
+  /// @param srcw 轉送元畫像の幅
+  /// @param srch 轉送元畫像の高さ
+  /// @param dstrect 轉送先の範圍
+  /// @param dstw 轉送先畫像の幅
+  /// @param dsth 轉送先畫像の高さ
+  /// @param cliprect 轉送先の變更可能な長方形の領域
+  StretchClipper_(
+    const Rect& srcrect, int srcw, int srch,
+    const Rect& dstrect, int dstw, int dsth,
+    const std::optional<Rect>& cliprect);
+
+  explicit operator bool() const { return flag_; }
+};
+
+
+/// @brief 雙一次補閒が可能な畫素型
+template<class C_>
+concept Interpolatable_ = requires(C_ c) { c.red; c.green; c.blue; };
+
+
+/**
+ * @brief 雙一次補閒
+ *
+ * fx, fyは0〜255の重み(256分率)。
+ */
+template<Interpolatable_ C_>
+C_ bilinear_(
+  const C_& p00, const C_& p10, const C_& p01, const C_& p11, int fx, int fy)
+  noexcept
+{
+  const int w00 = (256 - fx) * (256 - fy);
+  const int w10 = fx * (256 - fy);
+  const int w01 = (256 - fx) * fy;
+  const int w11 = fx * fy;
+
+  auto mix = [&](auto member) {
+    return
+      static_cast<std::uint8_t>(
+        (p00.*member * w00 + p10.*member * w10
+         + p01.*member * w01 + p11.*member * w11 + 32768) >> 16);
+  };
+
+  C_ res = p00;
+  res.red = mix(&C_::red);
+  res.green = mix(&C_::green);
+  res.blue = mix(&C_::blue);
+  if constexpr (requires { p00.alpha; })
+    res.alpha = mix(&C_::alpha);
+  return res;
+}
+
+
+/**
+ * @brief 轉送先の1ライン分の轉寫
+ *
+ * 轉送先のd[0]〜d[n-1]について、i = 0, 1, ... の順にsample()で得た畫素を
+ * copierで轉寫する。
+ * copierがRowCopierを滿たす場合は、標本を小分けに集めてから呼び出す。
+ */
+template<class CSrc, class C_, class Copier, class Sample>
+void stretchRow_(Copier& copier, C_* d, int n, Sample& sample)
+{
+  if constexpr (PlainCopier<Copier, CSrc, C_>) {
+    for (int i = 0; i < n; ++i)
+      d[i] = sample();
+  }
+  else if constexpr (RowCopier<Copier, CSrc, C_>) {
+    constexpr int CHUNK = 64;
+    CSrc buf[CHUNK];
+    for (int i = 0; i < n; i += CHUNK) {
+      int m = std::min(CHUNK, n - i);
+      for (int k = 0; k < m; ++k)
+        buf[k] = sample();
+      copier(static_cast<const CSrc*>(buf), d + i, m);
+    }
+  }
+  else {
+    for (int i = 0; i < n; ++i)
+      copier(sample(), d[i]);
+  }
+}
+
+
+/**
+ * @brief 最近傍法による擴大縮小轉送
+ */
+template<class CSrc, class C_, class Copier>
+void stretchNearest_(
+  const ImageBuffer<CSrc>& src, ImageBuffer<C_>& dst,
+  const StretchClipper_& clipper, Copier& copier)
+{
+  constexpr int SHIFT = StretchClipper_::FRAC_BITS;
+
+  long long v = clipper.v0;
+  for (int j = 0; j < clipper.h; ++j, v += clipper.dv) {
+    const CSrc* srow = src.lineBuffer(static_cast<int>(v >> SHIFT));
+    long long u = clipper.u0;
+    auto sample = [srow, &u, du = clipper.du] {
+      const CSrc& p = srow[u >> SHIFT];
+      u += du;
+      return p;
+    };
+    stretchRow_<CSrc>(
+      copier, dst.lineBuffer(clipper.dy + j) + clipper.dx, clipper.w, sample);
+  }
+}
+
+
+/**
+ * @brief 雙一次補閒の近傍と重み
+ *
+ * 畫素の中心を整數座標とする固定小數點數の位置pについて、
+ * 近傍の二畫素の座標i0, i1を[lo, hi)に收めて求め、
+ * 8bitの重みfを求める。
+ */
+inline void
+splitCoord_(long long p, int lo, int hi, int& i0, int& i1, int& f) noexcept
+{
+  constexpr int SHIFT = StretchClipper_::FRAC_BITS;
+
+  long long i = p >> SHIFT;
+  f = static_cast<int>((p >> (SHIFT - 8)) & 0xFF);
+  i0 = static_cast<int>(std::clamp<long long>(i, lo, hi - 1));
+  i1 = static_cast<int>(std::clamp<long long>(i + 1, lo, hi - 1));
+}
+
+
+/**
+ * @brief 雙一次補閒法による擴大縮小轉送
+ *
+ * 近傍の畫素が參照してよい範圍の外にある場合は、範圍の端の畫素で代用する。
+ */
+template<class CSrc, class C_, class Copier>
+void stretchBilinear_(
+  const ImageBuffer<CSrc>& src, ImageBuffer<C_>& dst,
+  const StretchClipper_& clipper, Copier& copier)
+{
+  constexpr long long HALF = StretchClipper_::ONE / 2;
+
+  long long v = clipper.v0 - HALF;
+  for (int j = 0; j < clipper.h; ++j, v += clipper.dv) {
+    int y0, y1, fy;
+    splitCoord_(v, clipper.stop, clipper.sbottom, y0, y1, fy);
+    const CSrc* row0 = src.lineBuffer(y0);
+    const CSrc* row1 = src.lineBuffer(y1);
+
+    long long u = clipper.u0 - HALF;
+    auto sample = [&] {
+      int x0, x1, fx;
+      splitCoord_(u, clipper.sleft, clipper.sright, x0, x1, fx);
+      u += clipper.du;
+      return bilinear_(row0[x0], row0[x1], row1[x0], row1[x1], fx, fy);
+    };
+    stretchRow_<CSrc>(
+      copier, dst.lineBuffer(clipper.dy + j) + clipper.dx, clipper.w, sample);
+  }
+}
+
+
+}//end of namespace eunomia::implement_
+
+
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::stretchBlt(
+  const eunomia::ImageBuffer<CSrc>& src,
+  const eunomia::Rect& srcrect, const eunomia::Rect& dstrect,
+  const std::optional<eunomia::Rect>& cliprect, Copier copier,
+  eunomia::StretchFilter filter)
+{
+  implement_::StretchClipper_
+    clipper(
+      srcrect, src.width(), src.height(),
+      dstrect, width(), height(), cliprect);
+
+  if (!clipper)
+    return;
+
+  damaged_(
+    clipper.dx, clipper.dy, clipper.dx + clipper.w, clipper.dy + clipper.h);
+
+  if constexpr (implement_::Interpolatable_<CSrc>) {
+    if (filter == StretchFilter::Bilinear) {
+      implement_::stretchBilinear_(src, *this, clipper, copier);
+      return;
+    }
+  }
+  implement_::stretchNearest_(src, *this, clipper, copier);
+}
+
+
+
+
+//eof
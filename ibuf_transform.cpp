@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_transform.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファのアフィン變換を伴ふ轉送のクリッピングの實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <cmath>
+#include "imagebuffer.h"
+
+
+namespace {
+
+using eunomia::implement_::StretchClipper_;
+
+
+/*
+ * @brief 一次式による制約
+ *
+ * 整數xについて 0 <= p0 + k * x < hi となる範圍を[lo, up)に絞り込む。
+ * @return 範圍が空でなければtrue
+ */
+bool constrain_(double p0, double k, double hi, double& lo, double& up)
+  noexcept
+{
+  if (k == 0.0)
+    return 0.0 <= p0 && p0 < hi;
+
+  double t1 = -p0 / k;
+  double t2 = (hi - p0) / k;
+  if (k > 0.0) {
+    lo = std::max(lo, std::ceil(t1));
+    up = std::min(up, std::ceil(t2));
+  }
+  else {
+    lo = std::max(lo, std::floor(t2) + 1.0);
+    up = std::min(up, std::floor(t1) + 1.0);
+  }
+  return lo < up;
+}
+
+
+// 座標を固定小數點數にする(溢れないやう範圍を制限する)
+inline long long toFixed_(double x, int size) noexcept
+{
+  x = std::clamp(x, -1.0, size + 1.0);
+  return std::llround(x * StretchClipper_::ONE);
+}
+
+
+}// end of NONAME namespace
+
+
+eunomia::implement_::TransformClipper_::TransformClipper_(
+  const AffineMatrix& m, int srcw, int srch, int dstw, int dsth,
+  const std::optional<Rect>& cliprect)
+  : srcw_(srcw), srch_(srch), flag_(false)
+{
+  auto inv = m.inverse();
+  if (!inv || srcw <= 0 || srch <= 0)
+    return;
+  inv_ = *inv;
+
+  // 轉送先の變更してよい範圍
+  double xlo = 0, ylo = 0, xhi = dstw, yhi = dsth;
+  if (cliprect) {
+    xlo = std::max<double>(xlo, cliprect->left);
+    ylo = std::max<double>(ylo, cliprect->top);
+    xhi = std::min<double>(xhi, cliprect->right);
+    yhi = std::min<double>(yhi, cliprect->bottom);
+  }
+
+  // 轉送元の四隅の寫像を圍むY座標の範圍
+  double ys[4] = {
+    m.mapY(0, 0), m.mapY(srcw, 0), m.mapY(0, srch), m.mapY(srcw, srch) };
+  double ymin = std::min({ys[0], ys[1], ys[2], ys[3]});
+  double ymax = std::max({ys[0], ys[1], ys[2], ys[3]});
+  if (!std::isfinite(ymin) || !std::isfinite(ymax))
+    return;
+
+  ylo = std::max(ylo, std::floor(ymin));
+  yhi = std::min(yhi, std::ceil(ymax));
+  if (xlo >= xhi || ylo >= yhi)
+    return;
+
+  top = static_cast<int>(ylo);
+  bottom = static_cast<int>(yhi);
+  xlo_ = static_cast<int>(xlo);
+  xhi_ = static_cast<int>(xhi);
+
+  // 增分が大きすぎる變換(極端な縮小)は扱はない
+  if (std::abs(inv_.a) > srcw || std::abs(inv_.c) > srch)
+    return;
+  du = std::llround(inv_.a * StretchClipper_::ONE);
+  dv = std::llround(inv_.c * StretchClipper_::ONE);
+
+  flag_ = true;
+}
+
+
+bool
+eunomia::implement_::TransformClipper_::span(int y, Span& res) const noexcept
+{
+  // X座標xの畫素の中心(x + 1/2, y + 1/2)は轉送元の (pu + a * x, pv + c * x)
+  double py = y + 0.5;
+  double pu = inv_.mapX(0.5, py);
+  double pv = inv_.mapY(0.5, py);
+
+  double lo = xlo_;
+  double up = xhi_;
+  if (
+    !constrain_(pu, inv_.a, srcw_, lo, up)
+    || !constrain_(pv, inv_.c, srch_, lo, up))
+    return false;
+
+  int left = static_cast<int>(lo);
+  int right = static_cast<int>(up);
+
+  // 固定小數點で辿つた座標が範圍に收まるやう兩端を調整する
+  // (座標は線形に變化するので兩端を調べれば十分である)
+  auto inside = [this](long long u, long long v) {
+    constexpr int SHIFT = StretchClipper_::FRAC_BITS;
+    return
+      u >= 0 && (u >> SHIFT) < srcw_ && v >= 0 && (v >> SHIFT) < srch_;
+  };
+
+  long long u = toFixed_(pu + inv_.a * left, srcw_);
+  long long v = toFixed_(pv + inv_.c * left, srch_);
+  while (left < right && !inside(u, v)) {
+    ++left;
+    u += du;
+    v += dv;
+  }
+  while (
+    left < right
+    && !inside(u + (right - 1 - left) * du, v + (right - 1 - left) * dv))
+    --right;
+
+  if (left >= right)
+    return false;
+
+  res.left = left;
+  res.right = right;
+  res.u = u;
+  res.v = v;
+  return true;
+}
+
+
+//eof
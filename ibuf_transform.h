@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file ibuf_transform.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファクラステンプレートのtransformBlt()の實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+/* This file is included by "imagebuffer.h". */
+
+
+namespace eunomia::implement_
+{
+/**
+ * @brief アフィン變換を伴ふ轉送のクリッピング處理クラス
+ *
+ * 轉送先のライン毎に、畫素の中心が轉送元の畫像の内側に寫される範圍を求める。
+ * 轉送元の座標はStretchClipper_と同じく32bitの小數部を持つ固定小數點數で表す。
+ */
+class TransformClipper_
+{
+public:
+  /// @brief 轉送先の1ライン中の轉送範圍
+  struct Span
+  {
+    int left;     ///< 左端のX座標
+    int right;    ///< 右端のX座標(範圍に含まない)
+    long long u;  ///< 左端の畫素の中心に對應する轉送元のX座標
+    long long v;  ///< 左端の畫素の中心に對應する轉送元のY座標
+  };
+
+  int top;     ///< 轉送先の上端のY座標
+  int bottom;  ///< 轉送先の下端のY座標(範圍に含まない)
+  long long du;  ///< 轉送先のX方向の1畫素あたりの轉送元のX座標の增分
+  long long dv;  ///< 轉送先のX方向の1畫素あたりの轉送元のY座標の增分
+
+private:
+  AffineMatrix inv_;  // 轉送先から轉送元への變換
+  int srcw_;
+  int srch_;
+  int xlo_;
+  int xhi_;
+  bool flag_;
+
+public:
+  /// @brief 構築子
+  ///
+  /// @param m 轉送元の座標を轉送先の座標に寫す變換
+  /// @param srcw 轉送元畫像の幅
+  /// @param srch 轉送元畫像の高さ
+  /// @param dstw 轉送先畫像の幅
+  /// @param dsth 轉送先畫像の高さ
+  /// @param cliprect 轉送先の變更可能な長方形の領域
+  TransformClipper_(
+    const AffineMatrix& m, int srcw, int srch, int dstw, int dsth,
+    const std::optional<Rect>& cliprect);
+
+  explicit operator bool() const { return flag_; }
+
+  /// @brief 轉送先のY座標yのラインの轉送範圍
+  /// @return 範圍が空でなければtrue
+  bool span(int y, Span& res) const noexcept;
+};
+
+
+}//end of namespace eunomia::implement_
+
+
+
+
+template<class C_> template<class CSrc, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::transformBlt(
+  const eunomia::ImageBuffer<CSrc>& src, const eunomia::AffineMatrix& m,
+  const std::optional<eunomia::Rect>& cliprect, Copier copier,
+  eunomia::StretchFilter filter)
+{
+  using implement_::StretchClipper_;
+  using implement_::TransformClipper_;
+  constexpr int SHIFT = StretchClipper_::FRAC_BITS;
+
+  TransformClipper_
+    clipper(m, src.width(), src.height(), width(), height(), cliprect);
+
+  if (!clipper)
+    return;
+
+  // 變更した範圍
+  int left = width(), right = 0, top = clipper.bottom, bottom = clipper.top;
+
+  for (int y = clipper.top; y < clipper.bottom; ++y) {
+    TransformClipper_::Span sp;
+    if (!clipper.span(y, sp))
+      continue;
+
+    left = std::min(left, sp.left);
+    right = std::max(right, sp.right);
+    top = std::min(top, y);
+    bottom = y + 1;
+
+    C_* d = lineBuffer(y) + sp.left;
+    int n = sp.right - sp.left;
+    long long u = sp.u;
+    long long v = sp.v;
+
+    if constexpr (implement_::Interpolatable_<CSrc>) {
+      if (filter == StretchFilter::Bilinear) {
+        constexpr long long HALF = StretchClipper_::ONE / 2;
+        auto sample = [&] {
+          int x0, x1, fx, y0, y1, fy;
+          implement_::splitCoord_(u - HALF, 0, src.width(), x0, x1, fx);
+          implement_::splitCoord_(v - HALF, 0, src.height(), y0, y1, fy);
+          u += clipper.du;
+          v += clipper.dv;
+          const CSrc* row0 = src.lineBuffer(y0);
+          const CSrc* row1 = src.lineBuffer(y1);
+          return
+            implement_::bilinear_(
+              row0[x0], row0[x1], row1[x0], row1[x1], fx, fy);
+        };
+        implement_::stretchRow_<CSrc>(copier, d, n, sample);
+        continue;
+      }
+    }
+
+    auto sample = [&] {
+      const CSrc& p = src.lineBuffer(v >> SHIFT)[u >> SHIFT];
+      u += clipper.du;
+      v += clipper.dv;
+      return p;
+    };
+    implement_::stretchRow_<CSrc>(copier, d, n, sample);
+  }
+
+  damaged_(left, top, right, bottom);
+}
+
+
+
+
+//eof
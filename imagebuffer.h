@@ -36,15 +36,36 @@
  *  @date 2021.4.29 v0.1
  *    LIBPOLYMNIAの畫像バッファクラステンプレートから改作
  *
+ *  @date 2026.10.17 forEachRow()と竝列版のforEachPixel()を追加
+ *  @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ *  @date 2026.10.17 1ライン單位の轉寫を行ふcopierに對應
+ *  @date 2026.10.17 同一畫素型の單純轉送をmemmove()で行ふやうに變更
+ *  @date 2026.10.17 竝列版のblt()を追加
+ *  @date 2026.10.17 擴大縮小を伴ふ轉送stretchBlt()を追加
+ *  @date 2026.10.17 アフィン變換を伴ふ轉送transformBlt()を追加
+ *  @date 2026.10.17 SpriteRleの轉送を追加
+ *  @date 2026.10.17 變更範圍の追跡を追加
+ *  @date 2026.10.17 多角形の塗り潰しfillPolygon()を追加
+ *  @date 2026.10.17 copierを用ゐる楕圓の塗り潰しfillEllipse()を追加
+ *  @date 2026.10.17 アンチエイリアス描畫lineAA()等を追加
+ *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_H
 #define INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_H
 
 #include <algorithm>
 #include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include "affine.h"
+#include "damage.h"
 #include "exception.h"
 #include "noncopyable.h"
+#include "parallel.h"
 #include "rect.h"
 
 
@@ -74,6 +95,78 @@ public:
 };
 
 
+/**
+ * @brief 1ライン單位の轉寫を行ふ函數オブジェクト
+ *
+ * copier(sp, dp, n)の形で呼び出すことができ、
+ * 轉送元の畫素列sp[0]〜sp[n-1]を轉送先の畫素列dp[0]〜dp[n-1]に轉寫するもの。
+ * ImageBuffer::blt()等はこれを滿たすcopierを1ライン毎に一度だけ呼び出し、
+ * 滿たさないcopierはピクセル毎に呼び出す。
+ */
+template<class Copier, class CSrc, class C_>
+concept RowCopier
+  = requires(Copier& copier, const CSrc* sp, C_* dp, int n) {
+      copier(sp, dp, n);
+    };
+
+
+/**
+ * @brief 畫素をそのまま複寫する函數オブジェクト
+ *
+ * 型Copierが入れ子型PlainCopyTagを持ち、
+ * かつ轉送元と轉送先の畫素型が同一で、トリビアルにコピー可能であるもの。
+ * ImageBuffer::blt()等はこれを滿たすcopierを呼び出さず、
+ * 1ライン毎のmemmove()(ピッチが揃つてゐれば一度のmemmove())で轉送する。
+ */
+template<class Copier, class CSrc, class C_>
+concept PlainCopier
+  = requires { typename Copier::PlainCopyTag; }
+    && std::is_same_v<CSrc, C_>
+    && std::is_trivially_copyable_v<C_>;
+
+
+/**
+ * @brief 代入による轉寫を行ふ函數オブジェクトクラス
+ *
+ * 引數を省略したblt()で用ゐられる。
+ */
+class AssignCopier
+{
+public:
+  using PlainCopyTag = void;
+
+  template<class CSrc, class C_>
+  void operator()(const CSrc& src, C_& dst) const
+  {
+    dst = src;
+  }
+};
+
+
+
+
+template<class C_> class SpriteRle;
+template<class C_> class Compositor;
+
+
+/**
+ * @brief 擴大縮小を伴ふ轉送の標本化の方法
+ */
+enum class StretchFilter
+{
+  Nearest,   ///< 最近傍法
+  Bilinear,  ///< 雙一次補閒法
+};
+
+
+/**
+ * @brief 多角形の内側の判定規則
+ */
+enum class FillRule
+{
+  EvenOdd,  ///< 交叉する邊の數が奇數ならば内側(偶奇規則)
+  NonZero,  ///< 邊の囘轉數が0でなければ内側(非零規則)
+};
 
 
 /**
@@ -89,7 +182,11 @@ protected:
   std::uint8_t* buf_;  ///< 畫像バッファ
   int w_;  ///< 幅
   int h_;  ///< 高さ
-  int pitch_;  ///< ピッチ = 水平方向1ラインのビット數
+  std::ptrdiff_t pitch_;  ///< ピッチ = 水平方向1ラインのバイト數
+  std::optional<DamageRegion> damage_;  ///< 變更範圍(追跡しない場合は空)
+
+  // Compositorは竝列に轉送する間、變更範圍を外して自ら記録する
+  template<class> friend class Compositor;
 
   /// @brief 構築子
   ///
@@ -98,10 +195,21 @@ protected:
   /// @param w 幅
   /// @param h 高さ
   /// @param p ピッチ
-  ImageBuffer(int w, int h, int p) noexcept
+  ImageBuffer(int w, int h, std::ptrdiff_t p) noexcept
     : buf_(nullptr), w_(w), h_(h), pitch_(p)
     {}
 
+  /// @brief 變更範圍の記録
+  ///
+  /// 變更範圍を追跡してゐる場合に、
+  /// 畫像の範圍に切り詰め濟みの長方形(left, top)-(right, bottom)を記録する。
+  /// 右端、下端は含まない。
+  void damaged_(int left, int top, int right, int bottom)
+  {
+    if (damage_)
+      damage_->add(Rect(left, top, right, bottom));
+  }
+
 public:
   /// 解體子
   virtual ~ImageBuffer() = default;
@@ -115,7 +223,10 @@ public:
   /// @brief 高さ
   int height() const noexcept { return h_; }
   /// @brief ピッチ
-  int pitch() const noexcept { return pitch_; }
+  ///
+  /// 2GiBを超える畫像でもオフセットが溢れないやう、
+  /// ピッチは std::ptrdiff_t で保持する。
+  std::ptrdiff_t pitch() const noexcept { return pitch_; }
 
   /// @brief バッファの先頭アドレスの取得
   uint8_t* buffer() noexcept { return buf_; }
@@ -169,6 +280,61 @@ public:
   }
 
 
+  //====================================
+  //  變更範圍の追跡
+  //====================================
+
+  /// @brief 變更範圍の追跡の開始
+  ///
+  /// 以後、line()、box()、ellipse()、paintFill()、clear()、
+  /// blt()などの轉送、forEachPixel()、forEachRow()が
+  /// 變更した範圍をdamage()に記録する。
+  /// pixel()やlineBuffer()を通じて直接畫素を變更した場合は記録されないので、
+  /// markDamaged()で知らせること。
+  /// ImageView<C_>などで參照した先の變更も記録されない。
+  /// 既に追跡してゐる場合は何もしない。
+  /// 記憶領域の確保に失敗した場合はstd::bad_allocを投げる。
+  void enableDamageTracking()
+  {
+    if (!damage_)
+      damage_.emplace();
+  }
+
+  /// @brief 變更範圍の追跡の終了
+  ///
+  /// 記録した範圍は破棄する。
+  void disableDamageTracking() noexcept { damage_.reset(); }
+
+  /// @brief 變更範圍を追跡してゐればtrue
+  bool isTrackingDamage() const noexcept { return damage_.has_value(); }
+
+  /// @brief 變更範圍
+  ///
+  /// 前回のresetDamage()以降に變更された範圍を返す。
+  /// 追跡してゐない場合はnullptrを返す。
+  const DamageRegion* damage() const noexcept
+    { return damage_ ? &*damage_ : nullptr; }
+
+  /// @brief 記録した變更範圍を空にする
+  void resetDamage() noexcept
+  {
+    if (damage_)
+      damage_->clear();
+  }
+
+  /// @brief 變更範圍の通知
+  ///
+  /// 長方形rectの範圍を變更したものとして記録する。
+  /// rectは畫像の範圍に切り詰められる。右端、下端は含まない。
+  /// 追跡してゐない場合は何もしない。
+  void markDamaged(const Rect& rect)
+  {
+    damaged_(
+      std::max(rect.left, 0), std::max(rect.top, 0),
+      std::min(rect.right, w_), std::min(rect.bottom, h_));
+  }
+
+
   //==================================================================
   //  圖形描畫
   //==================================================================
@@ -214,12 +380,114 @@ public:
     ellipse(x, y, r, r, color, fill);
   }
 
+  /// @brief 楕圓の塗り潰し
+  ///
+  /// ellipse()で塗り潰すのと同じ範圍に、1ラインにつき1區間づつ
+  /// copierで色colorを轉寫する。copierの扱ひはblt()に同じ。
+  /// @param x 中心のX座標
+  /// @param y 中心のY座標
+  /// @param a 水平方向の半徑
+  /// @param b 垂直方向の半徑
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  template<class CSrc, class Copier>
+  void fillEllipse(
+    int x, int y, int a, int b, const CSrc& color, Copier copier);
+
+  /// @brief 圓の塗り潰し
+  ///
+  /// fillEllipse()に同じ。
+  /// @param x 中心のX座標
+  /// @param y 中心のY座標
+  /// @param r 半徑
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  template<class CSrc, class Copier>
+  void fillCircle(int x, int y, int r, const CSrc& color, Copier copier)
+  {
+    fillEllipse(x, y, r, r, color, copier);
+  }
+
   /// @brief 塗り潰し
   /// @param x 始點のX座標
   /// @param y 始點のY座標
   /// @param color 色
   void paintFill(int x, int y, const C_& color);
 
+  /// @brief 多角形の塗り潰し
+  ///
+  /// 頂點を順に結んだ多角形の内側を走査線毎に塗り潰す。
+  /// 中心が内側にある畫素のみを塗るので、邊の上の畫素が塗られるとは
+  /// 限らない。輪郭が必要ならline()等で別に描くこと。
+  /// @param points 頂點。最後の頂點と最初の頂點も邊で結ぶ。
+  ///   座標の絶對値は2^28未滿であること。
+  /// @param color 色
+  /// @param rule 内側の判定規則
+  void fillPolygon(
+    std::span<const Point> points, const C_& color,
+    FillRule rule = FillRule::EvenOdd);
+
+  /// @brief 多角形の塗り潰し
+  ///
+  /// 塗り潰す區間毎にcopierで色colorを轉寫する。
+  /// copierの扱ひはblt()に同じ。
+  /// @param points 頂點
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  /// @param rule 内側の判定規則
+  template<class CSrc, class Copier>
+  void fillPolygon(
+    std::span<const Point> points, const CSrc& color, Copier copier,
+    FillRule rule = FillRule::EvenOdd);
+
+  /// @brief アンチエイリアスを施した直線の描畫
+  ///
+  /// Wuのアルゴリズムで各畫素の被覆率(0〜255)を求め、
+  /// 不透明度alphaに被覆率を乘じた色をcopierで轉寫する。
+  /// CSrcは非乘算濟みのアルファ値を持つ型で、
+  /// 公開メンバ變數alphaを持つこと。copierはアルファブレンディングを行ふもの
+  /// (AlphaBrendCopier等)を想定する。
+  /// 被覆率は1ライン毎に纏めて求め、被覆率が0でない區間毎にcopierを呼ぶ。
+  /// @param x1 始點のX座標
+  /// @param y1 始點のY座標
+  /// @param x2 終點のX座標
+  /// @param y2 終點のY座標
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  template<class CSrc, class Copier>
+  void lineAA(
+    int x1, int y1, int x2, int y2, const CSrc& color, Copier copier);
+
+  /// @brief アンチエイリアスを施した圓の描畫
+  ///
+  /// 畫素の中心から圓周までの距離で被覆率を求める。
+  /// 塗り潰す場合はcircle()で塗り潰す範圍の境界を滑らかにしたものとなる。
+  /// CSrcとcopierの扱ひはlineAA()に同じ。
+  /// @param x 中心のX座標
+  /// @param y 中心のY座標
+  /// @param r 半徑
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  /// @param fill 塗り潰すならtrue、さもなくばfalse
+  template<class CSrc, class Copier>
+  void circleAA(
+    int x, int y, int r, const CSrc& color, Copier copier, bool fill = false);
+
+  /// @brief アンチエイリアスを施した多角形の塗り潰し
+  ///
+  /// 各畫素の正方形と多角形の重なる面積を被覆率とする。
+  /// 頂點の扱ひはfillPolygon()に同じ。
+  /// 邊の交叉する部分や重なる部分に掛かる畫素の被覆率は近似となる。
+  /// CSrcとcopierの扱ひはlineAA()に同じ。
+  /// @param points 頂點
+  /// @param color 色
+  /// @param copier 轉寫處理を行ふ函數オブジェクト
+  /// @param rule 内側の判定規則
+  template<class CSrc, class Copier>
+  void fillPolygonAA(
+    std::span<const Point> points, const CSrc& color, Copier copier,
+    FillRule rule = FillRule::EvenOdd);
+
   /// @brief バッファ全體の塗り潰し
   /// @param color 色
   void clear(const C_& color);
@@ -250,6 +518,10 @@ public:
   ///   轉送元(src)の畫素 const CSrc& s を
   ///   轉送先(*this)の畫素 C_& d に轉寫するときに、
   ///   copier(s, d)の形で呼び出される。
+  ///   copierがRowCopierを滿たす場合は、
+  ///   ピクセル毎ではなくクリッピング後の1ライン毎に
+  ///   copier(sp, dp, n)の形で一度だけ呼び出される。
+  ///   PlainCopierを滿たす場合は呼び出されず、memmove()で轉送される。
   template<class CSrc, class Copier>
   void
   blt(
@@ -274,10 +546,249 @@ public:
   blt(
     const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
     int dx, int dy, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(src, sx, sy, w, h, dx, dy, cliprect, AssignCopier());
+  }
+
+  /// @brief 竝列轉送
+  ///
+  /// クリッピング後の轉送先の範圍を高々threads本の横長の帶に分け、
+  /// 各帶の轉送を別々のスレッドで行ふ。
+  /// 1スレッドあたりの畫素數がMIN_PIXELS_PER_THREADに滿たない場合は
+  /// スレッド數を減らし、小さな轉送は呼び出したスレッドのみで行ふ。
+  ///
+  /// copierはスレッド毎に複製されて呼び出される。
+  /// 轉送元と轉送先が同じ畫像バッファである場合、
+  /// 兩者の範圍が重なつてはならない。
+  ///
+  /// @param threads スレッド數
+  /// @param src 轉送元畫像バッファ
+  /// @param sx 轉送元左上X座標
+  /// @param sy 轉送元左上Y座標
+  /// @param w 轉送幅
+  /// @param h 轉送高さ
+  /// @param dx 左上X座標
+  /// @param dy 左上Y座標
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param copier blt()に同じ。
+  template<class CSrc, class Copier>
+  void
+  blt(
+    int threads,
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect, Copier copier);
+
+  /// @brief 竝列轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる竝列版のblt()。
+  template<class CSrc>
+  void
+  blt(
+    int threads,
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(threads, src, sx, sy, w, h, dx, dy, cliprect, AssignCopier());
+  }
+
+  /// @brief 竝列轉送
+  ///
+  /// 實行ポリシーに應じたスレッド數でblt(int, ...)を行ふ。
+  /// @param policy execution::seq、execution::parなど
+  template<class Policy, class CSrc, class Copier>
+    requires isExecutionPolicy<Policy>
+  void
+  blt(
+    Policy&& policy,
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect, Copier copier)
   {
     blt(
-      src, sx, sy, w, h, dx, dy, cliprect,
-      [](const CSrc& spixel, C_& dpixel){ dpixel = spixel; });
+      threadCountFor(policy), src, sx, sy, w, h, dx, dy, cliprect, copier);
+  }
+
+  /// @brief 竝列轉送
+  ///
+  /// 實行ポリシーに應じたスレッド數でblt(int, ...)を行ふ。
+  /// @param policy execution::seq、execution::parなど
+  template<class Policy, class CSrc>
+    requires isExecutionPolicy<Policy>
+  void
+  blt(
+    Policy&& policy,
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(threadCountFor(policy), src, sx, sy, w, h, dx, dy, cliprect);
+  }
+
+  /// @brief 變更範圍の轉送
+  ///
+  /// 轉送元畫像srcのうちregionの各長方形の範圍のみを、
+  /// srcの左上が(dx, dy)に來るやうに轉送する。
+  /// 例へばsrc.damage()を與へると、前回轉送した後に變更された部分のみを
+  /// 畫面などに轉送し直すことができる。
+  /// regionは轉送先自身の變更範圍であつてもよい。
+  ///
+  /// @param src 轉送元畫像バッファ
+  /// @param region 轉送する範圍
+  /// @param dx srcの左上に對應するX座標
+  /// @param dy srcの左上に對應するY座標
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param copier blt()に同じ。
+  template<class CSrc, class Copier>
+  void
+  blt(
+    const ImageBuffer<CSrc>& src, const DamageRegion& region, int dx, int dy,
+    const std::optional<Rect>& cliprect, Copier copier)
+  {
+    // regionが*thisの變更範圍である場合、轉送の度に記録される長方形で
+    // 書き換はるので、寫しを取つてから轉送する
+    const std::vector<Rect> rects = region.rects();
+    for (const auto& r : rects)
+      blt(
+        src, r.left, r.top, r.width(), r.height(),
+        dx + r.left, dy + r.top, cliprect, copier);
+  }
+
+  /// @brief 變更範圍の轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  blt(
+    const ImageBuffer<CSrc>& src, const DamageRegion& region, int dx, int dy,
+    const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(src, region, dx, dy, cliprect, AssignCopier());
+  }
+
+  /// @brief スプライトの轉送
+  ///
+  /// スプライトsrcを、その左上が(dx, dy)に來るやうに轉送する。
+  /// srcの連の畫素のみを處理し、透明な畫素は處理しない。
+  /// 不透明な連の畫素にはopaqueを、半透明な連の畫素にはcopierを用ゐる。
+  /// 例へばopaqueにNormalBrendCopier、copierにAlphaBrendCopierを與へると、
+  /// 不透明な部分を單純轉送し、半透明な部分のみをαブレンドする。
+  ///
+  /// この函數を用ゐるには"sprite_rle.h"をインクルードしなければならない。
+  ///
+  /// @param src 轉送元スプライト
+  /// @param dx 左上X座標
+  /// @param dy 左上Y座標
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param opaque 不透明な連の轉寫に用ゐる。blt()のcopierに同じ。
+  /// @param copier 半透明な連の轉寫に用ゐる。blt()のcopierに同じ。
+  template<class CSrc, class OpaqueCopier, class Copier>
+  void
+  blt(
+    const SpriteRle<CSrc>& src, int dx, int dy,
+    const std::optional<Rect>& cliprect, OpaqueCopier opaque, Copier copier);
+
+  /// @brief スプライトの轉送
+  ///
+  /// 全ての連の畫素にcopierを用ゐる。
+  template<class CSrc, class Copier>
+  void
+  blt(
+    const SpriteRle<CSrc>& src, int dx, int dy,
+    const std::optional<Rect>& cliprect, Copier copier)
+  {
+    blt(src, dx, dy, cliprect, copier, copier);
+  }
+
+  /// @brief スプライトの轉送
+  ///
+  /// 連の畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  blt(
+    const SpriteRle<CSrc>& src, int dx, int dy,
+    const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(src, dx, dy, cliprect, AssignCopier(), AssignCopier());
+  }
+
+  /// @brief 擴大縮小を伴ふ轉送
+  ///
+  /// 轉送元畫像srcのsrcrectの範圍を、*thisのdstrectの範圍に
+  /// 擴大あるいは縮小して轉送する。
+  /// 轉送先の各畫素について、その中心に對應する轉送元の位置から
+  /// 固定小數點のDDAで標本を得て、copierで轉寫する。
+  /// 一時的な畫像バッファは用ゐない。
+  ///
+  /// blt()と同じく、srcの範圍外に對應する畫素と、
+  /// *thisあるいはcliprectの範圍外の畫素は變更しない。
+  /// srcrectあるいはdstrectの幅または高さが正でなければ何もしない。
+  ///
+  /// StretchFilter::Bilinearは、CSrcが公開メンバ變數red, green, blue
+  /// (及びalpha)を持つ場合にのみ有効で、
+  /// さうでない場合(インデックスカラー等)は最近傍法で標本化する。
+  /// 雙一次補閒はsrcrectの外の畫素を參照しない。
+  ///
+  /// @param src 轉送元畫像バッファ
+  /// @param srcrect 轉送元の範圍
+  /// @param dstrect 轉送先の範圍
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param copier blt()に同じ。
+  /// @param filter 標本化の方法
+  template<class CSrc, class Copier>
+  void
+  stretchBlt(
+    const ImageBuffer<CSrc>& src, const Rect& srcrect, const Rect& dstrect,
+    const std::optional<Rect>& cliprect, Copier copier,
+    StretchFilter filter = StretchFilter::Nearest);
+
+  /// @brief 擴大縮小を伴ふ轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  stretchBlt(
+    const ImageBuffer<CSrc>& src, const Rect& srcrect, const Rect& dstrect,
+    const std::optional<Rect>& cliprect = std::nullopt,
+    StretchFilter filter = StretchFilter::Nearest)
+  {
+    stretchBlt(src, srcrect, dstrect, cliprect, AssignCopier(), filter);
+  }
+
+  /// @brief アフィン變換を伴ふ轉送
+  ///
+  /// 轉送元畫像srcの全體を、行列mで變換した位置に轉送する。
+  /// 回轉、剪斷、擴大縮小、平行移動を組み合はせることができる。
+  ///
+  /// 轉送先の各畫素について、その中心を逆變換した轉送元の位置から標本を得て、
+  /// copierで轉寫する。
+  /// 轉送先のライン毎に轉送元の内側に寫される範圍を先に求め、
+  /// 範圍内を固定小數點のDDAで辿るので、範圍外の畫素は一切處理しない。
+  /// *thisあるいはcliprectの範圍外の畫素は變更しない。
+  /// mが逆變換を持たない場合は何もしない。
+  ///
+  /// @param src 轉送元畫像バッファ
+  /// @param m
+  ///   轉送元の座標を轉送先の座標に寫す變換。
+  ///   轉送元の畫素(x, y)は[x, x + 1)×[y, y + 1)の正方形を占めるものとする。
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param copier blt()に同じ。
+  /// @param filter 標本化の方法。stretchBlt()に同じ。
+  template<class CSrc, class Copier>
+  void
+  transformBlt(
+    const ImageBuffer<CSrc>& src, const AffineMatrix& m,
+    const std::optional<Rect>& cliprect, Copier copier,
+    StretchFilter filter = StretchFilter::Nearest);
+
+  /// @brief アフィン變換を伴ふ轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  transformBlt(
+    const ImageBuffer<CSrc>& src, const AffineMatrix& m,
+    const std::optional<Rect>& cliprect = std::nullopt,
+    StretchFilter filter = StretchFilter::Nearest)
+  {
+    transformBlt(src, m, cliprect, AssignCopier(), filter);
   }
 
 
@@ -295,9 +806,110 @@ public:
   template<class Func>
   void forEachPixel(Func func)
   {
+    damaged_(0, 0, w_, h_);
     for (int j = 0; j < h_; ++j)
       std::for_each_n(lineBuffer(j), w_, func);
   }
+
+  /// @brief 畫素毎の竝列處理
+  ///
+  /// 畫像を高々threads本の横長の帶に分け、
+  /// 各帶の畫素へのfuncの處理を別々のスレッドで行ふ。
+  /// funcは複數のスレッドから同時に呼び出されるので、
+  /// 畫素以外の状態を變更してはならない。
+  /// @param threads スレッド數
+  /// @param func forEachPixel(Func)に同じ。
+  template<class Func>
+  void forEachPixel(int threads, Func func)
+  {
+    damaged_(0, 0, w_, h_);
+    implement_::parallelRows_(
+      h_, threads,
+      [this, &func](int begin, int end) {
+        for (int j = begin; j < end; ++j)
+          std::for_each_n(lineBuffer(j), w_, func);
+      });
+  }
+
+  /// @brief 畫素毎の竝列處理
+  ///
+  /// 實行ポリシーに應じたスレッド數でforEachPixel(int, Func)を行ふ。
+  /// execution::seqならば單一のスレッドで、
+  /// execution::parならばdefaultThreadCount()本のスレッドで處理する。
+  /// @param policy execution::seq、execution::parなど
+  /// @param func forEachPixel(Func)に同じ。
+  template<class Policy, class Func>
+    requires isExecutionPolicy<Policy>
+  void forEachPixel(Policy&& policy, Func func)
+  {
+    forEachPixel(threadCountFor(policy), func);
+  }
+
+  /// @brief ライン毎の處理
+  ///
+  /// 畫像の各ラインにfuncとして與へられる處理を行ふ。
+  /// 一ライン分の畫素をまとめて渡すので、
+  /// funcの内側のループをベクトル化しやすい。
+  /// @param func
+  ///   各ラインへの處理を行ふ函數あるいは函數オブジェクト。
+  ///   Y座標yのライン std::span<C_> row を處理するときに、
+  ///   func(row, y) あるいは func(row) の形で呼び出される。
+  template<class Func>
+  void forEachRow(Func func)
+  {
+    damaged_(0, 0, w_, h_);
+    forEachRows_(0, h_, func);
+  }
+
+  /// @brief ライン毎の竝列處理
+  ///
+  /// 畫像を高々threads本の横長の帶に分け、
+  /// 各帶のラインへのfuncの處理を別々のスレッドで行ふ。
+  /// funcは複數のスレッドから同時に呼び出される。
+  /// @param threads スレッド數
+  /// @param func forEachRow(Func)に同じ。
+  template<class Func>
+  void forEachRow(int threads, Func func)
+  {
+    damaged_(0, 0, w_, h_);
+    implement_::parallelRows_(
+      h_, threads,
+      [this, &func](int begin, int end) { forEachRows_(begin, end, func); });
+  }
+
+  /// @brief ライン毎の竝列處理
+  ///
+  /// 實行ポリシーに應じたスレッド數でforEachRow(int, Func)を行ふ。
+  /// @param policy execution::seq、execution::parなど
+  /// @param func forEachRow(Func)に同じ。
+  template<class Policy, class Func>
+    requires isExecutionPolicy<Policy>
+  void forEachRow(Policy&& policy, Func func)
+  {
+    forEachRow(threadCountFor(policy), func);
+  }
+
+private:
+  template<class CSrc, class Copier, class Cover>
+  void blendCoverage_(const CSrc& color, Copier& copier, Cover cover);
+
+  template<class Func>
+  void scanEllipse_(int x, int y, int a, int b, Func func);
+
+  template<class Func>
+  void scanPolygon_(std::span<const Point> points, FillRule rule, Func func);
+
+  template<class Func>
+  void forEachRows_(int begin, int end, Func& func)
+  {
+    for (int j = begin; j < end; ++j) {
+      std::span<C_> row(lineBuffer(j), w_);
+      if constexpr (std::is_invocable_v<Func&, std::span<C_>, int>)
+        func(row, j);
+      else
+        func(row);
+    }
+  }
 };
 
 
@@ -323,6 +935,10 @@ void grayscale(C_& pixel)
 
 
 #include "ibuf_blt.h"
+#include "ibuf_stretch.h"
+#include "ibuf_transform.h"
+#include "ibuf_polygon.h"
+#include "ibuf_antialias.h"
 #include "ibuf_draw.h"
 
 
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file imagebuffer_planar.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief チャネル毎の面(プレーン)を持つ畫像バッファ
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_PLANAR_H
+#define INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_PLANAR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include "imagebuffer.h"
+#include "colour.h"
+#include "noncopyable.h"
+#include "pixelbuffer.h"
+
+
+namespace eunomia
+{
+  class Picture;
+  class PictureRgba;
+
+
+/**
+ * @brief チャネル毎の面(プレーン)を持つ畫像バッファクラステンプレート
+ *
+ * N_個のチャネルの各々を、連續した一枚の面として保持する。
+ * 各面の先頭アドレスはBUFFER_ALIGNMENTに整列し、
+ * 全ての面は同じピッチを持つ。
+ * チャネルの番號は、0が赤、1が緑、2が青、3がαである。
+ *
+ * チャネル毎に獨立した處理を、畫素の分解なしに連續したメモリに對して
+ * 行へるので、SIMD化しやすい。
+ */
+template<int N_>
+class ImageBufferPlanar : Noncopyable<ImageBufferPlanar<N_>>
+{
+  static_assert(N_ > 0, "ImageBufferPlanar needs at least one channel");
+
+public:
+  /// @brief チャネル數
+  static constexpr int CHANNELS = N_;
+
+private:
+  PixelBufferPtr upbuf_;  ///< 全ての面を收める領域
+  std::uint8_t* plane_[N_];  ///< 各面の先頭アドレス
+  int w_;  ///< 幅
+  int h_;  ///< 高さ
+  std::ptrdiff_t pitch_;  ///< ピッチ(各面の水平方向1ラインのバイト數)
+
+  /// @brief 構築子
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param align ピッチの整列單位(バイト數)
+  /// @param init 初期化方針
+  ImageBufferPlanar(unsigned w, unsigned h, int align, InitPolicy init)
+    : w_(w), h_(h), pitch_(alignPitch(w, align))
+  {
+    auto psize = alignPitch(bufferBytes(pitch_, h), BUFFER_ALIGNMENT);
+    upbuf_ = allocatePixelBuffer(bufferBytes(psize, N_));
+    if (init == InitPolicy::Initialized)
+      std::fill_n(upbuf_.get(), psize * N_, 0);
+    for (int c = 0; c < N_; ++c)
+      plane_[c] = upbuf_.get() + psize * c;
+  }
+
+public:
+  /// @brief 畫像バッファ生成
+  ///
+  /// 幅と高さを指定してImageBufferPlanarオブジェクトを生成する。
+  /// 各面の先頭アドレスはBUFFER_ALIGNMENTに整列し、
+  /// ピッチはalignの倍數に切り上げられる。
+  /// 記憶領域は既定の確保器(defaultBufferAllocator())から確保する。
+  /// 幅または高さがintで表せない場合は失敗してnullptrを返す。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<ImageBufferPlanar>
+  create(unsigned w, unsigned h, int align = DEFAULT_PITCH_ALIGNMENT) noexcept
+  {
+    return create(w, h, InitPolicy::Initialized, align);
+  }
+
+  /// @brief 畫像バッファ生成
+  ///
+  /// 初期化方針initを指定してオブジェクトを生成する。
+  /// InitPolicy::Uninitializedを指定した場合、
+  /// 畫素値は不定となるので、呼び出し側で全畫素を書き込まなければならない。
+  /// その他はcreate(w, h, align)と同じ。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<ImageBufferPlanar>
+  create(
+    unsigned w, unsigned h, InitPolicy init,
+    int align = DEFAULT_PITCH_ALIGNMENT) noexcept
+  {
+    if (align <= 0 || !isValidImageSize(w, h))
+      return nullptr;
+
+    try {
+      return
+        std::unique_ptr<ImageBufferPlanar>(
+          new ImageBufferPlanar(w, h, align, init));
+    }
+    catch (std::bad_alloc&) {
+      return nullptr;
+    }
+  }
+
+  /// @brief 複製
+  std::unique_ptr<ImageBufferPlanar> clone() const noexcept
+  {
+    auto res = create(w_, h_, InitPolicy::Uninitialized);
+    if (res)
+      for (int c = 0; c < N_; ++c)
+        for (int j = 0; j < h_; ++j)
+          std::copy_n(lineBuffer(c, j), w_, res->lineBuffer(c, j));
+    return res;
+  }
+
+  /// @brief 幅
+  int width() const noexcept { return w_; }
+  /// @brief 高さ
+  int height() const noexcept { return h_; }
+  /// @brief ピッチ
+  std::ptrdiff_t pitch() const noexcept { return pitch_; }
+
+  /// @brief 面の先頭アドレスの取得
+  /// @param c チャネル番號
+  std::uint8_t* plane(int c) noexcept { return plane_[c]; }
+  /// @brief 面の先頭アドレスの取得
+  /// @param c チャネル番號
+  const std::uint8_t* plane(int c) const noexcept { return plane_[c]; }
+
+  /// @brief 面のラインバッファの先頭アドレスの取得
+  /// @param c チャネル番號
+  /// @param y Y座標
+  std::uint8_t* lineBuffer(int c, int y) noexcept
+    { return plane_[c] + pitch_ * y; }
+
+  /// @brief 面のラインバッファの先頭アドレスの取得
+  /// @param c チャネル番號
+  /// @param y Y座標
+  const std::uint8_t* lineBuffer(int c, int y) const noexcept
+    { return plane_[c] + pitch_ * y; }
+
+  /// @brief 畫素(x, y)のチャネルcの値の參照
+  std::uint8_t& sample(int c, int x, int y) noexcept
+    { return lineBuffer(c, y)[x]; }
+
+  /// @brief 畫素(x, y)のチャネルcの値の參照
+  const std::uint8_t& sample(int c, int x, int y) const noexcept
+    { return lineBuffer(c, y)[x]; }
+};
+
+
+/// @brief RGBの3面からなる畫像バッファ
+using PlanarRgb = ImageBufferPlanar<3>;
+/// @brief RGBAの4面からなる畫像バッファ
+using PlanarRgba = ImageBufferPlanar<4>;
+
+
+
+
+//==================================================================
+//  畫素を竝べた畫像バッファとの變換
+//==================================================================
+
+/// @brief 面への分解
+///
+/// srcの各畫素をチャネル毎に分解してdstに書き込む。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+/// dstの領域を再確保しないので、同じ大きさの畫像の反復處理では
+/// 確保を伴はない。
+void deinterleave(
+  const ImageBuffer<RgbColour>& src, ImageBufferPlanar<3>& dst) noexcept;
+
+/// @brief 面への分解
+///
+/// srcの各畫素をチャネル毎に分解してdstに書き込む。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+void deinterleave(
+  const ImageBuffer<RgbaColour>& src, ImageBufferPlanar<4>& dst) noexcept;
+
+/// @brief 面からの合成
+///
+/// srcの各面の値を組み合はせた畫素をdstに書き込む。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+void interleave(
+  const ImageBufferPlanar<3>& src, ImageBuffer<RgbColour>& dst) noexcept;
+
+/// @brief 面からの合成
+///
+/// srcの各面の値を組み合はせた畫素をdstに書き込む。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+void interleave(
+  const ImageBufferPlanar<4>& src, ImageBuffer<RgbaColour>& dst) noexcept;
+
+/// @brief 面に分解した複製の生成
+std::unique_ptr<ImageBufferPlanar<3>>
+createPlanar(const ImageBuffer<RgbColour>& src) noexcept;
+
+/// @brief 面に分解した複製の生成
+std::unique_ptr<ImageBufferPlanar<4>>
+createPlanar(const ImageBuffer<RgbaColour>& src) noexcept;
+
+/// @brief 面を合成したPictureの生成
+std::unique_ptr<Picture>
+createPicture(const ImageBufferPlanar<3>& src) noexcept;
+
+/// @brief 面を合成したPictureRgbaの生成
+std::unique_ptr<PictureRgba>
+createPictureRgba(const ImageBufferPlanar<4>& src) noexcept;
+
+
+
+
+//==================================================================
+//  面毎の處理
+//==================================================================
+
+/// @brief 擴大
+///
+/// biCubic法で擴大した複製を生成する。
+/// 全ての面を同じやうに處理する。
+/// 縱方向と横方向の二段に分けて補間するので、
+/// 内側のループは一つの面の連續した畫素を走査する。
+///
+/// @param src 原畫像
+/// @param w 複製畫像の幅
+/// @param h 複製畫像の高さ
+/// @param a シャープネスを加減するパラメタ。Picture::magnify()を參照。
+template<int N_>
+std::unique_ptr<ImageBufferPlanar<N_>>
+magnify(const ImageBufferPlanar<N_>& src, int w, int h, double a = -1.0)
+  noexcept;
+
+/// @brief 縮小
+///
+/// 面積平均法で縮小した複製を生成する。
+/// 全ての面を同じやうに處理する。
+/// 縱方向に重み附きで足し合はせてから横方向に足し合はせるので、
+/// 加算の順序がPicture::reduce()と異なり、四捨五入の境目にある畫素では
+/// 結果が±1異なることがある。
+///
+/// @param src 原畫像
+/// @param w 複製畫像の幅
+/// @param h 複製畫像の高さ
+template<int N_>
+std::unique_ptr<ImageBufferPlanar<N_>>
+reduce(const ImageBufferPlanar<N_>& src, int w, int h) noexcept;
+
+/// @brief グレイスケール化
+///
+/// 面0, 1, 2を赤、緑、青として輝度を求め、その三面に書き込む。
+/// 面3以降(α)は變更しない。
+template<int N_>
+void grayscale(ImageBufferPlanar<N_>& image) noexcept;
+
+
+}// end of namespace eunomia
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_PLANAR_H
+
+
+
+//eof
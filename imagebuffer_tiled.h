@@ -0,0 +1,583 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file imagebuffer_tiled.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief タイル状に配置した畫像バッファ
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_TILED_H
+#define INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_TILED_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include "imagebuffer.h"
+#include "colour.h"
+#include "noncopyable.h"
+#include "pixelbuffer.h"
+
+
+namespace eunomia
+{
+  class Picture;
+  class PictureRgba;
+
+
+/**
+ * @brief タイル状に配置した畫像バッファクラステンプレート
+ *
+ * 畫像をTILE_SIZE×TILE_SIZE畫素のタイルに分け、
+ * 各タイルの畫素を連續した領域に收める。
+ * タイル内の畫素は行優先に、タイルは左上から行優先に竝ぶ。
+ * 右端と下端のタイルは畫像の外にはみ出す部分も確保される。
+ *
+ * 縱方向に隣接する畫素が近くに配置されるため、
+ * 幅の非常に大きな畫像で縱方向に走査する處理のキャッシュ効率が良い。
+ *
+ * 畫素の參照はImageBufferと同じくpixel()、at()で行ふ。
+ * lineBuffer()は存在しないので、一ライン單位の讀み書きには
+ * readLine()、writeLine()を用ゐる。
+ */
+template<class C_>
+class TiledImageBuffer : Noncopyable<TiledImageBuffer<C_>>
+{
+public:
+  typedef C_ ColourType;
+
+  /// @brief タイルの一邊の畫素數の二進對數
+  static constexpr int TILE_SHIFT = 6;
+  /// @brief タイルの一邊の畫素數
+  static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+  /// @brief タイル内座標を取り出すマスク
+  static constexpr int TILE_MASK = TILE_SIZE - 1;
+  /// @brief タイル一枚の畫素數
+  static constexpr std::size_t TILE_PIXELS
+    = static_cast<std::size_t>(TILE_SIZE) * TILE_SIZE;
+
+private:
+  PixelBufferPtr upbuf_;  ///< 全てのタイルを收める領域
+  C_* tiles_;  ///< 先頭のタイル
+  int w_;  ///< 幅
+  int h_;  ///< 高さ
+  int tw_;  ///< 横方向のタイル數
+  int th_;  ///< 縱方向のタイル數
+
+  /// @brief 構築子
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  TiledImageBuffer(unsigned w, unsigned h, InitPolicy init)
+    : w_(w), h_(h),
+      tw_((w + TILE_MASK) >> TILE_SHIFT), th_((h + TILE_MASK) >> TILE_SHIFT)
+  {
+    auto size = bufferBytes(
+      sizeof(C_) * TILE_PIXELS * static_cast<std::size_t>(tw_), th_);
+    upbuf_ = allocatePixelBuffer(size);
+    if (init == InitPolicy::Initialized)
+      std::fill_n(upbuf_.get(), size, 0);
+    tiles_ = reinterpret_cast<C_*>(upbuf_.get());
+  }
+
+public:
+  /// @brief 畫像バッファ生成
+  ///
+  /// 幅と高さを指定してTiledImageBufferオブジェクトを生成する。
+  /// 記憶領域は既定の確保器(defaultBufferAllocator())から確保する。
+  /// 幅または高さがintで表せない場合は失敗してnullptrを返す。
+  /// @param w 幅
+  /// @param h 高さ
+  static
+  std::unique_ptr<TiledImageBuffer> create(unsigned w, unsigned h) noexcept
+  {
+    return create(w, h, InitPolicy::Initialized);
+  }
+
+  /// @brief 畫像バッファ生成
+  ///
+  /// 初期化方針initを指定してオブジェクトを生成する。
+  /// InitPolicy::Uninitializedを指定した場合、
+  /// 畫像の外にはみ出す部分も含めて畫素値は不定となる。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  static
+  std::unique_ptr<TiledImageBuffer>
+  create(unsigned w, unsigned h, InitPolicy init) noexcept
+  {
+    if (!isValidImageSize(w, h))
+      return nullptr;
+
+    try {
+      return
+        std::unique_ptr<TiledImageBuffer>(new TiledImageBuffer(w, h, init));
+    }
+    catch (std::bad_alloc&) {
+      return nullptr;
+    }
+  }
+
+  /// @brief 複製
+  std::unique_ptr<TiledImageBuffer> clone() const noexcept
+  {
+    auto res = create(w_, h_, InitPolicy::Uninitialized);
+    if (res)
+      std::copy_n(tiles_, TILE_PIXELS * tw_ * th_, res->tiles_);
+    return res;
+  }
+
+  //====================================
+  //  各種情報取得
+  //====================================
+
+  /// @brief 幅
+  int width() const noexcept { return w_; }
+  /// @brief 高さ
+  int height() const noexcept { return h_; }
+  /// @brief 横方向のタイル數
+  int tileColumns() const noexcept { return tw_; }
+  /// @brief 縱方向のタイル數
+  int tileRows() const noexcept { return th_; }
+
+  /// @brief タイル(tx, ty)の先頭アドレスの取得
+  C_* tileBuffer(int tx, int ty) noexcept
+    { return tiles_ + TILE_PIXELS * (static_cast<std::size_t>(ty) * tw_ + tx); }
+
+  /// @brief タイル(tx, ty)の先頭アドレスの取得
+  const C_* tileBuffer(int tx, int ty) const noexcept
+    { return tiles_ + TILE_PIXELS * (static_cast<std::size_t>(ty) * tw_ + tx); }
+
+  /// @brief タイル(tx, ty)のj番目のラインの先頭アドレスの取得
+  C_* tileLine(int tx, int ty, int j) noexcept
+    { return tileBuffer(tx, ty) + j * TILE_SIZE; }
+
+  /// @brief タイル(tx, ty)のj番目のラインの先頭アドレスの取得
+  const C_* tileLine(int tx, int ty, int j) const noexcept
+    { return tileBuffer(tx, ty) + j * TILE_SIZE; }
+
+  //====================================
+  //  畫素の參照
+  //====================================
+
+  /// @brief 畫素(x, y)の參照
+  C_& pixel(int x, int y) noexcept
+  {
+    return
+      tileLine(x >> TILE_SHIFT, y >> TILE_SHIFT, y & TILE_MASK)[x & TILE_MASK];
+  }
+
+  /// @brief 畫素(x, y)の參照
+  const C_& pixel(int x, int y) const noexcept
+  {
+    return
+      tileLine(x >> TILE_SHIFT, y >> TILE_SHIFT, y & TILE_MASK)[x & TILE_MASK];
+  }
+
+  /// @brief 畫素(x, y)の參照
+  ///
+  /// 座標(x, y)が畫像の幅と高さの範圍にあるか確認し、
+  /// 範圍外の場合はRangeOverExceptionを投げる。
+  C_& at(int x, int y)
+  {
+    if (x < 0 || y < 0 || x >= w_ || y >= h_)
+      throw RangeOverException();
+    return pixel(x, y);
+  }
+
+  /// @brief 畫素(x, y)の參照
+  ///
+  /// 座標(x, y)が畫像の幅と高さの範圍にあるか確認し、
+  /// 範圍外の場合はRangeOverExceptionを投げる。
+  const C_& at(int x, int y) const
+  {
+    if (x < 0 || y < 0 || x >= w_ || y >= h_)
+      throw RangeOverException();
+    return pixel(x, y);
+  }
+
+  //====================================
+  //  ライン單位の讀み書き
+  //====================================
+
+  /// @brief 一ラインの讀み出し
+  ///
+  /// Y座標yのライン全體(width()畫素)をdstに書き出す。
+  void readLine(int y, C_* dst) const noexcept
+  {
+    int ty = y >> TILE_SHIFT;
+    int j = y & TILE_MASK;
+    for (int tx = 0; tx < tw_; ++tx) {
+      int n = std::min(TILE_SIZE, w_ - (tx << TILE_SHIFT));
+      std::copy_n(tileLine(tx, ty, j), n, dst + (tx << TILE_SHIFT));
+    }
+  }
+
+  /// @brief 一ラインの書き込み
+  ///
+  /// srcから讀んだwidth()畫素をY座標yのラインに書き込む。
+  void writeLine(int y, const C_* src) noexcept
+  {
+    int ty = y >> TILE_SHIFT;
+    int j = y & TILE_MASK;
+    for (int tx = 0; tx < tw_; ++tx) {
+      int n = std::min(TILE_SIZE, w_ - (tx << TILE_SHIFT));
+      std::copy_n(src + (tx << TILE_SHIFT), n, tileLine(tx, ty, j));
+    }
+  }
+
+  //====================================
+  //  描畫
+  //====================================
+
+  /// @brief バッファ全體の塗り潰し
+  void clear(const C_& color)
+  {
+    std::fill_n(tiles_, TILE_PIXELS * tw_ * th_, color);
+  }
+
+  /// @brief 長方形の描畫
+  ///
+  /// ImageBuffer::box()と同じく、兩端の座標を含む長方形を描く。
+  /// タイル毎に處理するので、縱の邊も連續した領域への書き込みになる。
+  ///
+  /// @param left 左邊のX座標
+  /// @param top 上邊のY座標
+  /// @param right 右邊のX座標
+  /// @param bottom 下邊のY座標
+  /// @param color 色
+  /// @param fill 塗り潰すならtrue、さもなくばfalse
+  void box(
+    int left, int top, int right, int bottom, const C_& color,
+    bool fill = false)
+  {
+    if (left > right)
+      std::swap(left, right);
+    if (top > bottom)
+      std::swap(top, bottom);
+
+    if (fill)
+      fillRect_(left, top, right + 1, bottom + 1, color);
+    else {
+      fillRect_(left, top, right + 1, top + 1, color);
+      fillRect_(left, bottom, right + 1, bottom + 1, color);
+      fillRect_(left, top, left + 1, bottom + 1, color);
+      fillRect_(right, top, right + 1, bottom + 1, color);
+    }
+  }
+
+  //====================================
+  //  轉送
+  //====================================
+
+  /// @brief 轉送
+  ///
+  /// ImageBuffer::blt()と同じく、
+  /// 轉送元畫像srcのsx, sy, w, hで指定される範圍から畫素を得て、
+  /// 對應する畫素にcopierとして與へられる處理を行ふ。
+  /// 轉送先のタイル毎に處理する。
+  ///
+  /// @param src 轉送元畫像バッファ
+  /// @param sx 轉送元左上X座標
+  /// @param sy 轉送元左上Y座標
+  /// @param w 轉送幅
+  /// @param h 轉送高さ
+  /// @param dx 左上X座標
+  /// @param dy 左上Y座標
+  /// @param cliprect 變更を許す長方形領域。std::nulloptの場合は畫像全體。
+  /// @param copier
+  ///   ピクセル毎の轉寫を行ふ函數あるいは函數オブジェクト。
+  ///   copier(const CSrc& s, C_& d)の形で呼び出される。
+  ///   RowCopierを滿たす場合はタイル内の1ライン毎に
+  ///   copier(const CSrc* sp, C_* dp, int n)の形で呼び出される。
+  template<class CSrc, class Copier>
+  void
+  blt(
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect, Copier copier)
+  {
+    bltTiles_(
+      src.width(), src.height(), sx, sy, w, h, dx, dy, cliprect,
+      [&src, &copier](int x, int y, int n, C_* d) {
+        implement_::copyRow_(copier, src.lineBuffer(y) + x, d, n);
+      });
+  }
+
+  /// @brief 轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  blt(
+    const ImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(src, sx, sy, w, h, dx, dy, cliprect, AssignCopier());
+  }
+
+  /// @brief タイル状の畫像バッファからの轉送
+  ///
+  /// 轉送元もタイル状である他はImageBuffer<CSrc>からの轉送と同じ。
+  template<class CSrc, class Copier>
+  void
+  blt(
+    const TiledImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect, Copier copier)
+  {
+    using Src = TiledImageBuffer<CSrc>;
+
+    bltTiles_(
+      src.width(), src.height(), sx, sy, w, h, dx, dy, cliprect,
+      [&src, &copier](int x, int y, int n, C_* d) {
+        // 轉送元のタイルの境界で區切る
+        while (n > 0) {
+          int k = std::min(n, Src::TILE_SIZE - (x & Src::TILE_MASK));
+          const CSrc* s
+            = src.tileLine(
+                x >> Src::TILE_SHIFT, y >> Src::TILE_SHIFT,
+                y & Src::TILE_MASK)
+              + (x & Src::TILE_MASK);
+          implement_::copyRow_(copier, s, d, k);
+          x += k;
+          d += k;
+          n -= k;
+        }
+      });
+  }
+
+  /// @brief タイル状の畫像バッファからの轉送
+  ///
+  /// 畫素を轉送元の畫素で置き換へる。
+  template<class CSrc>
+  void
+  blt(
+    const TiledImageBuffer<CSrc>& src, int sx, int sy, int w, int h,
+    int dx, int dy, const std::optional<Rect>& cliprect = std::nullopt)
+  {
+    blt(src, sx, sy, w, h, dx, dy, cliprect, AssignCopier());
+  }
+
+  //====================================
+  //  その他
+  //====================================
+
+  /// @brief 畫素毎の處理
+  ///
+  /// 畫像の各畫素にfuncとして與へられる處理を行ふ。
+  /// 畫素はタイル毎に走査する。
+  template<class Func>
+  void forEachPixel(Func func)
+  {
+    for (int ty = 0; ty < th_; ++ty)
+      for (int tx = 0; tx < tw_; ++tx) {
+        int n = std::min(TILE_SIZE, w_ - (tx << TILE_SHIFT));
+        int m = std::min(TILE_SIZE, h_ - (ty << TILE_SHIFT));
+        for (int j = 0; j < m; ++j)
+          std::for_each_n(tileLine(tx, ty, j), n, func);
+      }
+  }
+
+private:
+  /// 半開區間[x1, x2)×[y1, y2)を畫像の範圍に切り詰めて塗り潰す
+  void fillRect_(int x1, int y1, int x2, int y2, const C_& color)
+  {
+    x1 = std::max(x1, 0);
+    y1 = std::max(y1, 0);
+    x2 = std::min(x2, w_);
+    y2 = std::min(y2, h_);
+    if (x1 >= x2 || y1 >= y2)
+      return;
+
+    for (int ty = y1 >> TILE_SHIFT; ty <= (y2 - 1) >> TILE_SHIFT; ++ty) {
+      int j1 = std::max(y1, ty << TILE_SHIFT);
+      int j2 = std::min(y2, (ty + 1) << TILE_SHIFT);
+      for (int tx = x1 >> TILE_SHIFT; tx <= (x2 - 1) >> TILE_SHIFT; ++tx) {
+        int i1 = std::max(x1, tx << TILE_SHIFT);
+        int i2 = std::min(x2, (tx + 1) << TILE_SHIFT);
+        for (int j = j1; j < j2; ++j)
+          std::fill_n(
+            tileLine(tx, ty, j & TILE_MASK) + (i1 & TILE_MASK), i2 - i1, color);
+      }
+    }
+  }
+
+  /// 轉送のクリッピングとタイル毎の走査
+  ///
+  /// 轉送先の各タイルの各ラインについて、
+  /// span(轉送元X座標, 轉送元Y座標, 畫素數, 轉送先アドレス)を呼び出す。
+  template<class Span>
+  void
+  bltTiles_(
+    int srcw, int srch, int sx, int sy, int w, int h, int dx, int dy,
+    const std::optional<Rect>& cliprect, Span span)
+  {
+    implement_::Clipper_
+      clipper(sx, sy, srcw, srch, w, h, dx, dy, w_, h_, cliprect);
+    if (!clipper || clipper.w <= 0 || clipper.h <= 0)
+      return;
+
+    int x1 = clipper.dx;
+    int y1 = clipper.dy;
+    int x2 = x1 + clipper.w;
+    int y2 = y1 + clipper.h;
+    int ox = clipper.sx - x1;
+    int oy = clipper.sy - y1;
+
+    for (int ty = y1 >> TILE_SHIFT; ty <= (y2 - 1) >> TILE_SHIFT; ++ty) {
+      int j1 = std::max(y1, ty << TILE_SHIFT);
+      int j2 = std::min(y2, (ty + 1) << TILE_SHIFT);
+      for (int tx = x1 >> TILE_SHIFT; tx <= (x2 - 1) >> TILE_SHIFT; ++tx) {
+        int i1 = std::max(x1, tx << TILE_SHIFT);
+        int i2 = std::min(x2, (tx + 1) << TILE_SHIFT);
+        for (int j = j1; j < j2; ++j)
+          span(
+            i1 + ox, j + oy, i2 - i1,
+            tileLine(tx, ty, j & TILE_MASK) + (i1 & TILE_MASK));
+      }
+    }
+  }
+};
+
+
+
+
+//==================================================================
+//  線形配置の畫像バッファとの變換
+//==================================================================
+
+/// @brief タイル状への配置
+///
+/// srcの畫素をdstに寫す。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+template<class C_>
+inline
+void tile(const ImageBuffer<C_>& src, TiledImageBuffer<C_>& dst) noexcept
+{
+  dst.blt(src, 0, 0, src.width(), src.height(), 0, 0);
+}
+
+/// @brief 線形配置への復元
+///
+/// srcの畫素をdstに寫す。
+/// 幅と高さが異なる場合は、共通する左上の範圍のみを處理する。
+template<class C_>
+inline
+void untile(const TiledImageBuffer<C_>& src, ImageBuffer<C_>& dst) noexcept
+{
+  using Src = TiledImageBuffer<C_>;
+
+  int w = std::min(src.width(), dst.width());
+  int h = std::min(src.height(), dst.height());
+  for (int y = 0; y < h; ++y) {
+    C_* d = dst.lineBuffer(y);
+    for (int x = 0; x < w; x += Src::TILE_SIZE)
+      std::copy_n(
+        src.tileLine(
+          x >> Src::TILE_SHIFT, y >> Src::TILE_SHIFT, y & Src::TILE_MASK),
+        std::min(Src::TILE_SIZE, w - x), d + x);
+  }
+}
+
+/// @brief タイル状に配置した複製の生成
+template<class C_>
+inline
+std::unique_ptr<TiledImageBuffer<C_>>
+createTiled(const ImageBuffer<C_>& src) noexcept
+{
+  auto res = TiledImageBuffer<C_>::create(src.width(), src.height());
+  if (res)
+    tile(src, *res);
+  return res;
+}
+
+/// @brief 線形配置のPictureの生成
+///
+/// PNG、JPEG等の保存函數に渡すために用ゐる。
+std::unique_ptr<Picture>
+createPicture(const TiledImageBuffer<RgbColour>& src) noexcept;
+
+/// @brief 線形配置のPictureRgbaの生成
+std::unique_ptr<PictureRgba>
+createPictureRgba(const TiledImageBuffer<RgbaColour>& src) noexcept;
+
+
+
+
+//==================================================================
+//  擴大・縮小
+//==================================================================
+
+/// @brief 擴大
+///
+/// biCubic法で擴大した複製を生成する。
+/// 結果はPicture::magnify()と同じである。
+/// 擴大先のタイル毎に處理するので、參照する原畫像の範圍が局所化される。
+///
+/// @param src 原畫像
+/// @param w 複製畫像の幅
+/// @param h 複製畫像の高さ
+/// @param a シャープネスを加減するパラメタ。Picture::magnify()を參照。
+std::unique_ptr<TiledImageBuffer<RgbColour>>
+magnify(const TiledImageBuffer<RgbColour>& src, int w, int h, double a = -1.0)
+  noexcept;
+
+/// @brief 擴大
+///
+/// biCubic法で擴大した複製を生成する。
+/// 結果はPictureRgba::magnify()と同じである。
+std::unique_ptr<TiledImageBuffer<RgbaColour>>
+magnify(const TiledImageBuffer<RgbaColour>& src, int w, int h, double a = -1.0)
+  noexcept;
+
+/// @brief 縮小
+///
+/// 面積平均法で縮小した複製を生成する。
+/// 結果はPicture::reduce()と同じである。
+/// 縮小先のタイル毎に處理する。
+std::unique_ptr<TiledImageBuffer<RgbColour>>
+reduce(const TiledImageBuffer<RgbColour>& src, int w, int h) noexcept;
+
+/// @brief 縮小
+///
+/// 面積平均法で縮小した複製を生成する。
+/// 結果はPictureRgba::reduce()と同じである。
+std::unique_ptr<TiledImageBuffer<RgbaColour>>
+reduce(const TiledImageBuffer<RgbaColour>& src, int w, int h) noexcept;
+
+
+}// end of namespace eunomia
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_IMAGEBUFFER_TILED_H
+
+
+
+//eof
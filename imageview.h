@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file imageview.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの部分畫像を參照するビュー
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_IMAGE_VIEW_H
+#define INCLUDE_GUARD_EUNOMIA_IMAGE_VIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "imagebuffer.h"
+
+
+namespace eunomia
+{
+
+/**
+ * @brief 畫像バッファのビュー
+ *
+ * 他の畫像バッファ、あるいは外部の記憶領域の一部を參照する
+ * ImageBuffer<C_>。畫素の複製は一切行はず、記憶領域も所有しない。
+ * 參照先は、ビューよりも長く生存してゐなければならない。
+ *
+ * ImageBuffer<C_>の派生クラスであるから、
+ * blt()の轉送元や轉送先、forEachPixel()、各種圖形描畫などに
+ * そのまま用ゐることができる。
+ */
+template<class C_>
+class ImageView : public ImageBuffer<C_>
+{
+public:
+  /// @brief 構築子
+  ///
+  /// 畫像バッファimageのうち長方形rectの範圍を參照するビューを構築する。
+  /// rectのうちimageからはみ出る部分は切り詰められる。
+  /// @param image 參照先の畫像バッファ
+  /// @param rect 參照する範圍
+  ImageView(ImageBuffer<C_>& image, const Rect& rect) noexcept
+    : ImageBuffer<C_>(0, 0, image.pitch())
+  {
+    Rect r = rect;
+    r.normalize();
+
+    int left = std::clamp(r.left, 0, image.width());
+    int right = std::clamp(r.right, 0, image.width());
+    int top = std::clamp(r.top, 0, image.height());
+    int bottom = std::clamp(r.bottom, 0, image.height());
+
+    this->w_ = right - left;
+    this->h_ = bottom - top;
+    this->buf_ = image.buffer() + image.pitch() * top + sizeof(C_) * left;
+  }
+
+  /// @brief 構築子
+  ///
+  /// 外部の記憶領域を參照するビューを構築する。
+  /// @param buf 左上の畫素の先頭アドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  ImageView(std::uint8_t* buf, int w, int h, std::ptrdiff_t pitch) noexcept
+    : ImageBuffer<C_>(w, h, pitch)
+  {
+    this->buf_ = buf;
+  }
+};
+
+
+/**
+ * @brief 畫像バッファの讀み出し專用ビュー
+ *
+ * 他の畫像バッファ、あるいは外部の記憶領域の一部を讀み出し專用に參照する。
+ * const ImageBuffer<C_>& に變換できるので、
+ * blt()の轉送元や、畫像の保存、擴大縮小の對象として用ゐることができる。
+ * blt()のやうに畫素型が推論される函數テンプレートに渡す場合には、
+ * image()を用ゐること。
+ */
+template<class C_>
+class ConstImageView
+{
+private:
+  ImageView<C_> view_; ///< 實際のビュー
+
+public:
+  /// @brief 構築子
+  ///
+  /// 畫像バッファimageのうち長方形rectの範圍を參照するビューを構築する。
+  /// rectのうちimageからはみ出る部分は切り詰められる。
+  /// @param image 參照先の畫像バッファ
+  /// @param rect 參照する範圍
+  ConstImageView(const ImageBuffer<C_>& image, const Rect& rect) noexcept
+    : view_(const_cast<ImageBuffer<C_>&>(image), rect)
+    {}
+
+  /// @brief 構築子
+  ///
+  /// 外部の記憶領域を參照するビューを構築する。
+  /// @param buf 左上の畫素の先頭アドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  ConstImageView(
+    const std::uint8_t* buf, int w, int h, std::ptrdiff_t pitch) noexcept
+    : view_(const_cast<std::uint8_t*>(buf), w, h, pitch)
+    {}
+
+  /// @brief 畫像バッファとしての參照
+  const ImageBuffer<C_>& image() const noexcept { return view_; }
+
+  /// @brief 畫像バッファへの變換
+  operator const ImageBuffer<C_>&() const noexcept { return view_; }
+
+  /// @brief 幅
+  int width() const noexcept { return view_.width(); }
+  /// @brief 高さ
+  int height() const noexcept { return view_.height(); }
+  /// @brief ピッチ
+  std::ptrdiff_t pitch() const noexcept { return view_.pitch(); }
+};
+
+
+}// end of namespace eunomia
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_IMAGE_VIEW_H
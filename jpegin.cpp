@@ -28,7 +28,11 @@
  * @file jpegin.cpp
  * @author oZ/acy (名賀月晃嗣)
  *
+ * @date 2026.10.17 ラインのオフセットを std::ptrdiff_t で計算するやうに變更
+ * @date 2026.10.17 讀み込み先の畫像を初期化せずに生成するやうに變更
+ *
  */
+#include <cstddef>
 #include <cstdio>
 #include "jpegio.h"
 #include "jpegio_implement.h"
@@ -87,7 +91,9 @@ eunomia::loadJpeg(const std::filesystem::path& path) noexcept
       throw implement_::JpegIOException_();
     }
 
-    auto q = Picture::create(cinfo.output_width, cinfo.output_height);
+    auto q
+      = Picture::create(
+          cinfo.output_width, cinfo.output_height, InitPolicy::Uninitialized);
     if (!q) {
       debug::out() << debug::timestamp()
                    << "Pictureの生成に失敗した。" << std::endl;
@@ -96,8 +102,8 @@ eunomia::loadJpeg(const std::filesystem::path& path) noexcept
 
     JSAMPROW buf[1];
     std::uint8_t* resbuf = q->buffer();
-    int pitch = q->pitch();
-    int j = 0;
+    std::ptrdiff_t pitch = q->pitch();
+    std::ptrdiff_t j = 0;
     while (cinfo.output_scanline < cinfo.output_height) {
       buf[0] = (JSAMPROW)(resbuf + j);
       jpeg_read_scanlines(&cinfo, buf, 1);
@@ -30,6 +30,7 @@
  *  @brief JPEG畫像の入出力
  *
  *  @date 2021.4.29 v0.1
+ *  @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
  *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_JPEG_INPUT_OUTPUT_H
@@ -57,6 +58,7 @@ std::unique_ptr<Picture> loadJpeg(const std::filesystem::path& path) noexcept;
  * @brief JPEGファイルの保存
  *
  * 畫像をJPEG形式で保存する。
+ * PictureのほかImageView<RgbColour>なども保存できる。
  * @param pict 保存する畫像
  * @param path 保存すべきJPEGファイルのパス
  * @param prog プログレッシブ形式にするならtrue、さもなくばfalseを指定する。
@@ -65,7 +67,7 @@ std::unique_ptr<Picture> loadJpeg(const std::filesystem::path& path) noexcept;
  */
 bool
 saveJpeg(
-  const Picture& pict, const std::filesystem::path& path,
+  const ImageBuffer<RgbColour>& pict, const std::filesystem::path& path,
   bool prog = false, int quality = 75) noexcept;
 
 
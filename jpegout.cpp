@@ -29,9 +29,12 @@
  * @author oZ/acy
  *
  * @date 2021.4.29 LIBPOLYMNIAから改作
+ * @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
+ * @date 2026.10.17 ラインのオフセットを std::ptrdiff_t で計算するやうに變更
  *
  */
 
+#include <cstddef>
 #include <cstdio>
 #include "jpegio.h"
 #include "jpegio_implement.h"
@@ -59,7 +62,8 @@ std::FILE* openfile(const wchar_t* path)
 
 bool
 eunomia::saveJpeg(
-  const eunomia::Picture& pict, const std::filesystem::path& path,
+  const eunomia::ImageBuffer<eunomia::RgbColour>& pict,
+  const std::filesystem::path& path,
   bool prog, int quality) noexcept
 {
   auto outfile = openfile(path.c_str());
@@ -91,8 +95,8 @@ eunomia::saveJpeg(
 
     JSAMPROW buf[1];
     const std::uint8_t* srcbuf = pict.buffer();
-    int pitch = pict.pitch();
-    int j = 0;
+    std::ptrdiff_t pitch = pict.pitch();
+    std::ptrdiff_t j = 0;
     while (cinfo.next_scanline < cinfo.image_height) {
       buf[0] = (JSAMPROW)(srcbuf + j);
       jpeg_write_scanlines(&cinfo, buf, 1);
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file parallel.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像處理の竝列實行の補助
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_PARALLEL_H
+#define INCLUDE_GUARD_EUNOMIA_PARALLEL_H
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace eunomia
+{
+
+/// @brief 既定のスレッド數
+///
+/// ハードウェアの同時實行可能なスレッド數を返す。
+/// 取得できない場合は1を返す。
+inline int defaultThreadCount() noexcept
+{
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+/**
+ * @brief 實行ポリシー
+ *
+ * 竝列版の處理函數に與へて實行方法を指定する。
+ * 標準の<execution>は處理系によつてTBB等への依存を持ち込むため、
+ * 同樣の使ひ勝手の型をここで定義する。
+ */
+namespace execution
+{
+
+/// @brief 逐次實行を指定する實行ポリシー
+struct SequencedPolicy
+{
+};
+
+/// @brief 竝列實行を指定する實行ポリシー
+struct ParallelPolicy
+{
+  /// スレッド數。0以下ならdefaultThreadCount()
+  int threads = 0;
+};
+
+/// @brief 逐次實行
+inline constexpr SequencedPolicy seq{};
+/// @brief 既定のスレッド數による竝列實行
+inline constexpr ParallelPolicy par{};
+
+}// end of namespace execution
+
+
+/// @brief 實行ポリシー型か否か
+template<class Policy>
+inline constexpr bool isExecutionPolicy
+  = std::is_same_v<std::remove_cvref_t<Policy>, execution::SequencedPolicy>
+    || std::is_same_v<std::remove_cvref_t<Policy>, execution::ParallelPolicy>;
+
+
+/// @brief 實行ポリシーに對應するスレッド數
+inline int threadCountFor(execution::SequencedPolicy) noexcept
+{
+  return 1;
+}
+
+/// @brief 實行ポリシーに對應するスレッド數
+inline int threadCountFor(const execution::ParallelPolicy& policy) noexcept
+{
+  return policy.threads > 0 ? policy.threads : defaultThreadCount();
+}
+
+
+/// @brief 1スレッドあたりの畫素數の下限
+///
+/// 竝列版のblt()等は、1スレッドあたりの畫素數がこれに滿たないやうに
+/// スレッド數を減らす。小さな處理ではスレッドの生成の費用が上囘るため。
+inline constexpr long long MIN_PIXELS_PER_THREAD = 1 << 16;
+
+
+namespace implement_
+{
+
+/// @brief 處理する畫素數に應じたスレッド數
+///
+/// w * h 畫素の處理に用ゐるスレッド數を、
+/// 1スレッドあたりMIN_PIXELS_PER_THREAD畫素以上となるやうに
+/// threads以下に制限して返す。結果は1以上となる。
+inline int threadsForArea_(int threads, int w, int h) noexcept
+{
+  long long n = (long long)w * h / MIN_PIXELS_PER_THREAD;
+  return (int)std::clamp(n, 1LL, (long long)std::max(threads, 1));
+}
+
+
+/// @brief ライン範圍の竝列處理
+///
+/// [0, h)のラインを高々threads本の連續した帶に分け、
+/// 各帶についてfunc(begin, end)を別々のスレッドで呼び出す。
+/// 最後の帶は呼び出したスレッドで處理する。
+/// スレッドを生成できない場合は、殘りの帶を呼び出したスレッドで處理する。
+/// funcが例外を投げた場合は、全てのスレッドの終了を待つてから
+/// 最初の例外を投げ直す。
+template<class Func>
+void parallelRows_(int h, int threads, Func&& func)
+{
+  threads = std::min(threads, h);
+  if (threads <= 1) {
+    if (h > 0)
+      func(0, h);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(threads);
+  workers.reserve(threads - 1);
+
+  auto band = [h, threads](int i) { return (int)((long long)h * i / threads); };
+
+  int i = 0;
+  for (; i < threads - 1; ++i) {
+    try {
+      workers.emplace_back(
+        [&func, &errors, i, b = band(i), e = band(i + 1)] {
+          try {
+            func(b, e);
+          }
+          catch (...) {
+            errors[i] = std::current_exception();
+          }
+        });
+    }
+    catch (std::system_error&) {
+      break;
+    }
+  }
+
+  // 生成したスレッドに割り當てなかつた帶は自ら處理する
+  try {
+    func(band(i), h);
+  }
+  catch (...) {
+    errors[i] = std::current_exception();
+  }
+
+  for (auto& t : workers)
+    t.join();
+
+  for (auto& e : errors)
+    if (e)
+      std::rethrow_exception(e);
+}
+
+
+}// end of namespace implement_
+}// end of namespace eunomia
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_PARALLEL_H
+
+
+
+//eof
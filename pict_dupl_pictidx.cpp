@@ -31,9 +31,12 @@
  * @date 2019.8.29  返却型を生ポインタからunique_ptrに變更
  *
  * @date 2021.4.25 LIBPOLYMNIAからLIBEUNOMIAに移植
+ * @date 2026.10.17 處理先を與へるconvertToIndexed()を追加
+ * @date 2026.10.17 變換先の畫像を初期化せずに生成するやうに變更
  *
  */
 #include <memory>
+#include <new>
 #include "picture.h"
 
 #include "pict_indexing.h"
@@ -42,16 +45,32 @@
 std::unique_ptr<eunomia::PictureIndexed>
 eunomia::Picture::duplicatePictureIndexed() const noexcept
 {
-  auto pi = PictureIndexed::create(w_, h_);
-  if (pi) {
+  auto pi = PictureIndexed::create(w_, h_, InitPolicy::Uninitialized);
+  if (pi && !convertToIndexed(*this, *pi))
+    return nullptr;
+  return pi;
+}
 
-    implement_::generatePalette_(*this, pi->paletteBuffer());
-    implement_::PaletteFinder_ pf(pi->paletteBuffer());
 
-    implement_::decreaseColourUsingErrorDiffusion_(*this, *pi, pf);
-    //implement_::decreaseColourSimply_(*this, *pi, pf);
+bool
+eunomia::convertToIndexed(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src, eunomia::PictureIndexed& dst)
+  noexcept
+{
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
+
+  try {
+    implement_::generatePalette_(src, dst.paletteBuffer());
+    implement_::PaletteFinder_ pf(dst.paletteBuffer());
+
+    implement_::decreaseColourUsingErrorDiffusion_(src, dst, pf);
+    //implement_::decreaseColourSimply_(src, dst, pf);
   }
-  return pi;
+  catch (std::bad_alloc&) {
+    return false;
+  }
+  return true;
 }
 
 
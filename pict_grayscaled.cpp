@@ -33,31 +33,51 @@
  * @date 2019.8.29 返却型を生ポインタからunique_ptrに變更
  *
  * @date 2021.4.24 LIBPOLYMNIAからLIBEUNOMIAに移植
+ * @date 2026.10.17 grayscale()と處理先を與へる變換函數を追加
+ * @date 2026.10.17 變換先の畫像を初期化せずに生成するやうに變更
  *
  */
 #include "picture.h"
 #include "picture_indexed.h"
 
 
+void eunomia::Picture::grayscale() noexcept
+{
+  forEachPixel(eunomia::grayscale<RgbColour>);
+}
+
+
 std::unique_ptr<eunomia::PictureIndexed>
 eunomia::Picture::createGrayscaledPictureIndexed() const noexcept
 {
-  auto pi = PictureIndexed::create(w_, h_);
-  if (pi) {
-    // パレットの設定
-    for (int i = 0; i < 256; i++)
-      pi->palette(i) = RgbColour(i, i, i);
+  auto pi = PictureIndexed::create(w_, h_, InitPolicy::Uninitialized);
+  if (pi)
+    convertToGrayscaledIndexed(*this, *pi);
+  return pi;
+}
+
+
+bool
+eunomia::convertToGrayscaledIndexed(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src, eunomia::PictureIndexed& dst)
+  noexcept
+{
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
 
-    // グレイスケール化
-    for (int y = 0; y < h_; ++y) {
-      for (int x = 0; x < w_; ++x) {
-        const auto& p = pixel(x, y);
-        std::uint8_t l = p.red * 0.2990 + p.green * 0.5870 + p.blue * 0.1140;
-        pi->pixel(x, y) = l;
-      }
-    }
+  // パレットの設定
+  for (int i = 0; i < 256; i++)
+    dst.palette(i) = RgbColour(i, i, i);
+
+  // グレイスケール化
+  for (int y = 0; y < src.height(); ++y) {
+    const auto* s = src.lineBuffer(y);
+    auto* d = dst.lineBuffer(y);
+    for (int x = 0; x < src.width(); ++x)
+      d[x] = s[x].red * 0.2990 + s[x].green * 0.5870 + s[x].blue * 0.1140;
   }
-  return pi;
+
+  return true;
 }
 
 
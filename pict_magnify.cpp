@@ -35,6 +35,10 @@
  * @date 29 Aug MMXIX  返却型を生ポインタからunique_ptrに變更
  *
  * @date 23 Apr MMXXI  LIBPOLYMNIAからLIBEUNOMIAへの移植とパラメタの追加
+ * @date 17 Oct MMXXVI  任意のImageBuffer<RgbColour>を擴大する函數に分離
+ * @date 17 Oct MMXXVI  擴大先を呼び出し側が與へる函數を追加
+ * @date 17 Oct MMXXVI  擴大先の畫像を初期化せずに生成するやうに變更
+ * @date 17 Oct MMXXVI  變更範圍のみを擴大し直す函數を追加
  *
  */
 #include <algorithm>
@@ -45,20 +49,44 @@
 
 std::unique_ptr<eunomia::Picture> 
 eunomia::Picture::magnify(int w, int h, double a) const noexcept
+{
+  return eunomia::magnify(*this, w, h, a);
+}
+
+
+std::unique_ptr<eunomia::Picture> 
+eunomia::magnify(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src, int w, int h, double a)
+  noexcept
+{
+  auto pict = Picture::create(w, h, InitPolicy::Uninitialized);
+  if (pict)
+    magnify(src, *pict, a);
+  return pict;
+}
+
+
+namespace {
+
+// 擴大先のrectの範圍の畫素を求める
+void
+magnifyRect_(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst, double a, const eunomia::Rect& rect)
+  noexcept
 {
   using eunomia::implement_::fCubic_;
   using eunomia::implement_::innerProduct_;
   using eunomia::implement_::productMat14_44_;
 
-  auto pict = create(w, h);
-  if (!pict)
-    return nullptr;
+  int w = dst.width();
+  int h = dst.height();
 
   // X方向、Y方向の擴大率の逆數
-  double nrx = (double)width() / (double)w;
-  double nry = (double)height() / (double)h;
+  double nrx = (double)src.width() / (double)w;
+  double nry = (double)src.height() / (double)h;
 
-  for (int Y = 0; Y < h; Y++) { // Yは擴大畫像上のY座標
+  for (int Y = rect.top; Y < rect.bottom; Y++) { // Yは擴大畫像上のY座標
     double y0 = Y * nry;        // Yに對應する原畫像上のY座標
     double dy = y0 - (int)y0;   // その小數部分
 
@@ -75,11 +103,11 @@ eunomia::Picture::magnify(int w, int h, double a) const noexcept
       // はみ出る分の處置
       if (py[i] < 0)
         py[i] = 0;
-      else if (py[i] >= height())
-        py[i] = height() - 1;
+      else if (py[i] >= src.height())
+        py[i] = src.height() - 1;
     }
 
-    for (int X = 0; X < w; X++) { // Xは擴大畫像上のX座標
+    for (int X = rect.left; X < rect.right; X++) { // Xは擴大畫像上のX座標
       double x0 = X * nrx;        // Xに對應する原畫像上のX座標
       double dx = x0 - (int)x0;   // その小數部分
 
@@ -96,17 +124,17 @@ eunomia::Picture::magnify(int w, int h, double a) const noexcept
         // はみ出る分の處置
         if (px[i] < 0)
           px[i] = 0;
-        else if (px[i] >= width())
-          px[i] = width() - 1;
+        else if (px[i] >= src.width())
+          px[i] = src.width() - 1;
       }
 
       double rbuf[16], gbuf[16], bbuf[16]; // 近傍十六點のRGB値を入れる4*4行列
       for (int i=0; i < 4; i++)
         for (int j=0; j < 4; j++)
         {
-          rbuf[i + j * 4] = pixel(px[i], py[j]).red;
-          gbuf[i + j * 4] = pixel(px[i], py[j]).green;
-          bbuf[i + j * 4] = pixel(px[i], py[j]).blue;
+          rbuf[i + j * 4] = src.pixel(px[i], py[j]).red;
+          gbuf[i + j * 4] = src.pixel(px[i], py[j]).green;
+          bbuf[i + j * 4] = src.pixel(px[i], py[j]).blue;
         }
 
       double tmpR[4], tmpG[4], tmpB[4];
@@ -118,9 +146,9 @@ eunomia::Picture::magnify(int w, int h, double a) const noexcept
       double G = innerProduct_(4, tmpG, fx);
       double B = innerProduct_(4, tmpB, fx);
 
-      pict->pixel(X, Y).red = std::clamp(R, 0.0, 255.0);
-      pict->pixel(X, Y).green = std::clamp(G, 0.0, 255.0);
-      pict->pixel(X, Y).blue = std::clamp(B, 0.0, 255.0);
+      dst.pixel(X, Y).red = std::clamp(R, 0.0, 255.0);
+      dst.pixel(X, Y).green = std::clamp(G, 0.0, 255.0);
+      dst.pixel(X, Y).blue = std::clamp(B, 0.0, 255.0);
 
       /*
       std::uint8_t r, g, b;
@@ -145,12 +173,40 @@ eunomia::Picture::magnify(int w, int h, double a) const noexcept
       else
         b = (std::uint8_t)B;
 
-      pict->pixel(X, Y) = RgbColour(r, g, b);
+      dst.pixel(X, Y) = RgbColour(r, g, b);
       */
     }
   }
+}
 
-  return pict;
+
+}//end of namespace
+
+
+void
+eunomia::magnify(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst, double a) noexcept
+{
+  eunomia::Rect all(0, 0, dst.width(), dst.height());
+  magnifyRect_(src, dst, a, all);
+  dst.markDamaged(all);
+}
+
+
+void
+eunomia::magnify(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst,
+  const eunomia::DamageRegion& damage, double a) noexcept
+{
+  for (const auto& r : damage.rects()) {
+    auto rect
+      = eunomia::implement_::resizedDamage_(
+          r, src.width(), src.height(), dst.width(), dst.height(), 2);
+    magnifyRect_(src, dst, a, rect);
+    dst.markDamaged(rect);
+  }
 }
 
 
@@ -35,8 +35,13 @@
  * @date 29 Aug MMXIX  返却型を生ポインタからunique_ptrに變更
  *
  * @date 23 Apr MMXXI  LIBPOLYMNIAからLIBEUNOMIAに移植
+ * @date 17 Oct MMXXVI  任意のImageBuffer<RgbColour>を縮小する函數に分離
+ * @date 17 Oct MMXXVI  縮小先を呼び出し側が與へる函數を追加
+ * @date 17 Oct MMXXVI  縮小先の畫像を初期化せずに生成するやうに變更
+ * @date 17 Oct MMXXVI  變更範圍のみを縮小し直す函數を追加
  *
  */
+#include <algorithm>
 #include <cmath>
 #include "picture.h"
 
@@ -46,7 +51,8 @@ namespace {
 // 元畫像の(x1, y1)-(x2, y2)を一點に「凝縮」する
 eunomia::RgbColour
 condense_(
-  const eunomia::Picture& src, double x1, double y1, double x2, double y2)
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  double x1, double y1, double x2, double y2)
 {
   // 領域のbeginとendになる座標
   int bx = (int)x1; // or std::floor(x1);
@@ -113,35 +119,96 @@ condense_(
 std::unique_ptr<eunomia::Picture>
 eunomia::Picture::reduce(int w, int h) const noexcept
 {
-  auto pict = create(w, h);
-  if (!pict)
-    return nullptr;
+  return eunomia::reduce(*this, w, h);
+}
+
+
+std::unique_ptr<eunomia::Picture>
+eunomia::reduce(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src, int w, int h) noexcept
+{
+  auto pict = Picture::create(w, h, InitPolicy::Uninitialized);
+  if (pict)
+    reduce(src, *pict);
+  return pict;
+}
+
+
+namespace {
+
+// 縮小先のrectの範圍の畫素を求める
+void
+reduceRect_(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst, const eunomia::Rect& rect)
+  noexcept
+{
+  int w = dst.width();
+  int h = dst.height();
 
   // 元サイズ/縮小サイズ
-  double dw = (double)width() / (double)w;
-  double dh = (double)height() / (double)h;
+  double dw = (double)src.width() / (double)w;
+  double dh = (double)src.height() / (double)h;
 
-  for (int Y = 0; Y < h; Y++) { // Yは縮小畫像上の座標
+  for (int Y = rect.top; Y < rect.bottom; Y++) { // Yは縮小畫像上の座標
     // Yに對應する原畫像上の座標
     double y1 = Y * dh;
     double y2 = (Y + 1) * dh;
     
-    if (y2 > height())
+    if (y2 > src.height()) {
+      // 原畫像からはみ出す部分は生成直後の畫素値にしておく
+      for (; Y < rect.bottom; Y++)
+        std::fill(
+          dst.lineBuffer(Y) + rect.left, dst.lineBuffer(Y) + rect.right,
+          eunomia::RgbColour());
       break;
+    }
 
-    for (int X = 0; X < w; X++) { // Xは縮小畫像上の座標
+    for (int X = rect.left; X < rect.right; X++) { // Xは縮小畫像上の座標
       // Xに對應する原畫像上の座標
       double x1 = (double)X * dw;
       double x2 = (double)(X + 1) * dw;
 
-      if (x2 > width())
+      if (x2 > src.width()) {
+        std::fill(
+          dst.lineBuffer(Y) + X, dst.lineBuffer(Y) + rect.right,
+          eunomia::RgbColour());
         break;
+      }
 
-      pict->pixel(X, Y) = condense_(*this, x1, y1, x2, y2);
+      dst.pixel(X, Y) = condense_(src, x1, y1, x2, y2);
     }
   }
+}
 
-  return pict;
+
+}//end of namespace
+
+
+void
+eunomia::reduce(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst) noexcept
+{
+  eunomia::Rect all(0, 0, dst.width(), dst.height());
+  reduceRect_(src, dst, all);
+  dst.markDamaged(all);
+}
+
+
+void
+eunomia::reduce(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst,
+  const eunomia::DamageRegion& damage) noexcept
+{
+  for (const auto& r : damage.rects()) {
+    auto rect
+      = eunomia::implement_::resizedDamage_(
+          r, src.width(), src.height(), dst.width(), dst.height(), 0);
+    reduceRect_(src, dst, rect);
+    dst.markDamaged(rect);
+  }
 }
 
 
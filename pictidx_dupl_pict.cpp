@@ -29,6 +29,8 @@
  * @author oZ/acy
  * 
  * @date 2021.4.24 新規作成
+ * @date 2026.10.17 處理先を與へるconvertToRgb()を追加
+ * @date 2026.10.17 變換先の畫像を初期化せずに生成するやうに變更
  *
  */
 
@@ -41,16 +43,29 @@
 std::unique_ptr<eunomia::Picture>
 eunomia::PictureIndexed::duplicatePicture() const noexcept
 {
-  auto pict = Picture::create(w_, h_);
+  auto pict = Picture::create(w_, h_, InitPolicy::Uninitialized);
 
   if (pict)
-    pict->blt(
-      *this, 0, 0, w_, h_,
-      0, 0, std::nullopt,
-      NormalBrendCopierFromPictureIndexed(*this));
+    convertToRgb(*this, *pict);
 
   return pict;
 }
 
 
+bool
+eunomia::convertToRgb(
+  const eunomia::PictureIndexed& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst) noexcept
+{
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
+
+  dst.blt(
+    src, 0, 0, src.width(), src.height(),
+    0, 0, std::nullopt,
+    NormalBrendCopierFromPictureIndexed(src));
+  return true;
+}
+
+
 //eof
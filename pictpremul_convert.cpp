@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file pictpremul_convert.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 乘算濟みアルファと乘算濟みでないアルファとの閒の變換
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "picture_rgba.h"
+#include "picture_rgba_premul.h"
+
+
+namespace {
+
+// 逆數表: (n * RECIP_[a]) >> 32 は n < 65536 において n / a に一致する
+constexpr auto RECIP_ = [] {
+  std::array<std::uint64_t, 256> t{};
+  for (std::uint64_t a = 1; a < 256; ++a)
+    t[a] = ((std::uint64_t(1) << 32) + a - 1) / a;
+  return t;
+}();
+
+
+// (c * 255 + a / 2) / a を除算を用ゐずに求める
+inline std::uint8_t unmul_(std::uint8_t c, std::uint64_t r, int a) noexcept
+{
+  std::uint64_t n = c * 255 + a / 2;
+  return static_cast<std::uint8_t>(std::min((n * r) >> 32, std::uint64_t(255)));
+}
+
+
+}// end of NONAME namespace
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgba::premultiplied() const noexcept
+{
+  auto pict = PictureRgbaPremul::create(w_, h_, InitPolicy::Uninitialized);
+  if (pict)
+    convertToPremul(*this, *pict);
+  return pict;
+}
+
+
+std::unique_ptr<eunomia::PictureRgba>
+eunomia::PictureRgbaPremul::unpremultiplied() const noexcept
+{
+  auto pict = PictureRgba::create(w_, h_, InitPolicy::Uninitialized);
+  if (pict)
+    convertToStraight(*this, *pict);
+  return pict;
+}
+
+
+bool
+eunomia::convertToPremul(
+  const eunomia::ImageBuffer<eunomia::RgbaColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbaPremulColour>& dst) noexcept
+{
+  using eunomia::implement_::mulDiv255_;
+
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
+
+  int w = src.width();
+  for (int y = 0; y < src.height(); ++y) {
+    const RgbaColour* s = src.lineBuffer(y);
+    RgbaPremulColour* d = dst.lineBuffer(y);
+    for (int x = 0; x < w; ++x) {
+      int a = s[x].alpha;
+      d[x].red = mulDiv255_(s[x].red, a);
+      d[x].green = mulDiv255_(s[x].green, a);
+      d[x].blue = mulDiv255_(s[x].blue, a);
+      d[x].alpha = a;
+    }
+  }
+  return true;
+}
+
+
+bool
+eunomia::convertToStraight(
+  const eunomia::ImageBuffer<eunomia::RgbaPremulColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbaColour>& dst) noexcept
+{
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
+
+  int w = src.width();
+  for (int y = 0; y < src.height(); ++y) {
+    const RgbaPremulColour* s = src.lineBuffer(y);
+    RgbaColour* d = dst.lineBuffer(y);
+    for (int x = 0; x < w; ++x) {
+      int a = s[x].alpha;
+      if (a == 0)
+        d[x] = RgbaColour(0, 0, 0, 0);
+      else {
+        auto r = RECIP_[a];
+        d[x]
+          = RgbaColour(
+              unmul_(s[x].red, r, a), unmul_(s[x].green, r, a),
+              unmul_(s[x].blue, r, a), a);
+      }
+    }
+  }
+  return true;
+}
+
+
+
+
+//eof
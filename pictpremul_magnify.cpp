@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file pictpremul_magnify.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief PictureRgbaPremulの擴大處理 (biCubic法 參考: C MAGAZINE Oct. 1999)
+ *
+ * @date 2026.10.17 作成 (pictrgba_magnify.cppより改作)
+ *
+ */
+#include <algorithm>
+#include "picture_rgba_premul.h"
+
+#include "pict_magnify_func.h"
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgbaPremul::magnify(int w, int h, double a) const noexcept
+{
+  return eunomia::magnify(*this, w, h, a);
+}
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::magnify(
+  const eunomia::ImageBuffer<eunomia::RgbaPremulColour>& src,
+  int w, int h, double a) noexcept
+{
+  auto pict = PictureRgbaPremul::create(w, h, InitPolicy::Uninitialized);
+  if (pict)
+    magnify(src, *pict, a);
+  return pict;
+}
+
+
+void
+eunomia::magnify(
+  const eunomia::ImageBuffer<eunomia::RgbaPremulColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbaPremulColour>& dst, double a) noexcept
+{
+  using eunomia::implement_::fCubic_;
+  using eunomia::implement_::innerProduct_;
+  using eunomia::implement_::productMat14_44_;
+
+  int w = dst.width();
+  int h = dst.height();
+
+  // X方向、Y方向の擴大率の逆數
+  double nrx = (double)src.width() / (double)w;
+  double nry = (double)src.height() / (double)h;
+
+  for (int Y = 0; Y < h; Y++) { // Yは擴大畫像上のY座標
+    double y0 = Y * nry;        // Yに對應する原畫像上のY座標
+    double dy = y0 - (int)y0;   // その小數部分
+
+    double fy[4];
+    fy[0] = fCubic_(1.0 + dy, a);
+    fy[1] = fCubic_(dy, a);
+    fy[2] = fCubic_(1.0 - dy, a);
+    fy[3] = fCubic_(2.0 - dy, a);
+
+    int py[4]; // 原畫像上の近傍十六點(4*4)のY座標
+    for (int i = 0; i < 4; i++) {
+      py[i] = (int)y0 - 1 + i;
+
+      // はみ出る分の處置
+      if (py[i] < 0)
+        py[i] = 0;
+      else if (py[i] >= src.height())
+        py[i] = src.height() - 1;
+    }
+
+    for (int X = 0; X < w; X++) { // Xは擴大畫像上のX座標
+      double x0 = X * nrx;        // Xに對應する原畫像上のX座標
+      double dx = x0 - (int)x0;   // その小數部分
+
+      double fx[4];
+      fx[0] = fCubic_(1.0 + dx, a);
+      fx[1] = fCubic_(dx, a);
+      fx[2] = fCubic_(1.0 - dx, a);
+      fx[3] = fCubic_(2.0 - dx, a);
+
+      int px[4]; // 原畫像上の近傍十六點(4*4)のX座標
+      for (int i=0; i < 4; i++) {
+        px[i] = (int)x0 - 1 + i;
+
+        // はみ出る分の處置
+        if (px[i] < 0)
+          px[i] = 0;
+        else if (px[i] >= src.width())
+          px[i] = src.width() - 1;
+      }
+
+      // 近傍十六點のRGBA値を入れる4*4行列
+      double rbuf[16], gbuf[16], bbuf[16], abuf[16]; 
+      for (int i=0; i < 4; i++)
+        for (int j=0; j < 4; j++)
+        {
+          rbuf[i + j * 4] = src.pixel(px[i], py[j]).red;
+          gbuf[i + j * 4] = src.pixel(px[i], py[j]).green;
+          bbuf[i + j * 4] = src.pixel(px[i], py[j]).blue;
+          abuf[i + j * 4] = src.pixel(px[i], py[j]).alpha;
+        }
+
+      double tmpR[4], tmpG[4], tmpB[4], tmpA[4];
+      productMat14_44_(tmpR, fy, rbuf);
+      productMat14_44_(tmpG, fy, gbuf);
+      productMat14_44_(tmpB, fy, bbuf);
+      productMat14_44_(tmpA, fy, abuf);
+
+      double R = innerProduct_(4, tmpR, fx);
+      double G = innerProduct_(4, tmpG, fx);
+      double B = innerProduct_(4, tmpB, fx);
+      double A = innerProduct_(4, tmpA, fx);
+
+      // 乘算濟みの色要素はアルファ値を超えてはならない
+      auto& d = dst.pixel(X, Y);
+      d.alpha = std::clamp(A, 0.0, 255.0);
+      d.red = std::clamp(R, 0.0, (double)d.alpha);
+      d.green = std::clamp(G, 0.0, (double)d.alpha);
+      d.blue = std::clamp(B, 0.0, (double)d.alpha);
+    }
+  }
+}
+
+
+
+//eof
@@ -29,6 +29,8 @@
  * @author oZ/acy
  * 
  * @date 2021.4.24 新規作成
+ * @date 2026.10.17 處理先を與へるconvertToRgb()を追加
+ * @date 2026.10.17 變換先の畫像を初期化せずに生成するやうに變更
  *
  */
 
@@ -41,14 +43,28 @@
 std::unique_ptr<eunomia::Picture>
 eunomia::PictureRgba::stripAlpha() const noexcept
 {
-  auto pict = Picture::create(w_, h_);
+  auto pict = Picture::create(w_, h_, InitPolicy::Uninitialized);
 
   if (pict)
-    pict->blt(
-      *this, 0, 0, w_, h_,  0, 0, std::nullopt, NormalBrendCopier());
+    convertToRgb(*this, *pict);
 
   return pict;
 }
 
 
+bool
+eunomia::convertToRgb(
+  const eunomia::ImageBuffer<eunomia::RgbaColour>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst) noexcept
+{
+  if (src.width() != dst.width() || src.height() != dst.height())
+    return false;
+
+  dst.blt(
+    src, 0, 0, src.width(), src.height(), 0, 0, std::nullopt,
+    NormalBrendCopier());
+  return true;
+}
+
+
 //eof
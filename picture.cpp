@@ -34,27 +34,77 @@
  *
  * @date 2021.4.23 LIBPOLYMNIAからLIBEUNOMIAに移植
  *
+ * @date 2026.10.17 整列したバッファの確保とピッチの切り上げに對應
+ * @date 2026.10.17 外部の領域を用ゐるwrap()を追加
+ * @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ * @date 2026.10.17 初期化方針を指定するcreate()を追加
+ *
  */
 
 #include <algorithm>
 #include <new>
+#include <utility>
 #include "picture.h"
 
 
-eunomia::Picture::Picture(unsigned w, unsigned h)
+eunomia::Picture::Picture(
+  unsigned w, unsigned h, int align, InitPolicy init)
   : 
-  ImageBuffer<RgbColour>(w, h, w * sizeof(RgbColour)),
-  upbuf_(std::make_unique<RgbColour[]>(w * h))
+  ImageBuffer<RgbColour>(w, h, alignPitch(w * sizeof(RgbColour), align)),
+  upbuf_(allocatePixelBuffer(bufferBytes(pitch_, h)))
+{
+  buf_ = upbuf_.get();
+  if (init == InitPolicy::Initialized)
+    std::fill_n(buf_, bufferBytes(pitch_, h_), 0);
+}
+
+
+eunomia::Picture::Picture(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept
+  : ImageBuffer<RgbColour>(w, h, pitch)
 {
-  buf_ = reinterpret_cast<std::uint8_t*>(upbuf_.get());
+  buf_ = buf;
 }
 
 
 std::unique_ptr<eunomia::Picture>
-eunomia::Picture::create(unsigned w, unsigned h) noexcept
+eunomia::Picture::create(unsigned w, unsigned h, int align) noexcept
 {
+  return create(w, h, InitPolicy::Initialized, align);
+}
+
+
+std::unique_ptr<eunomia::Picture>
+eunomia::Picture::create(
+  unsigned w, unsigned h, InitPolicy init, int align) noexcept
+{
+  if (align <= 0 || !isValidImageSize(w, h))
+    return nullptr;
+
   try {
-    return std::unique_ptr<Picture>(new Picture(w, h));
+    return std::unique_ptr<Picture>(new Picture(w, h, align, init));
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+std::unique_ptr<eunomia::Picture>
+eunomia::Picture::wrap(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+  eunomia::ExternalBufferDeleter deleter) noexcept
+{
+  if (!buf || !isValidImageSize(w, h))
+    return nullptr;
+  auto rowbytes = static_cast<std::ptrdiff_t>(w * sizeof(RgbColour));
+  if ((pitch < 0 ? -pitch : pitch) < rowbytes)
+    return nullptr;
+
+  try {
+    std::unique_ptr<Picture> res(new Picture(buf, w, h, pitch));
+    res->upbuf_ = adoptPixelBuffer(buf, std::move(deleter));
+    return res;
   }
   catch (std::bad_alloc&) {
     return nullptr;
@@ -65,25 +115,13 @@ eunomia::Picture::create(unsigned w, unsigned h) noexcept
 std::unique_ptr<eunomia::Picture>
 eunomia::Picture::clone() const noexcept
 {
-  auto res = create(w_, h_);
+  auto res = create(w_, h_, InitPolicy::Uninitialized);
   if (res)
-    std::copy_n(buf_, h_ * pitch_, res->buf_);
+    for (int j = 0; j < h_; ++j)
+      std::copy_n(lineBuffer(j), w_, res->lineBuffer(j));
   return res;
 }
 
-/*
-void eunomia::Picture::grayscale() noexcept
-{
-  for (int i = 0; i < w_ * h_; ++i) {
-    std::uint8_t l 
-      = upbuf_[i].red * 0.2990 + upbuf_[i].green * 0.5870
-        + upbuf_[i].blue * 0.1140;
-    upbuf_[i].red = l;
-    upbuf_[i].green = l;
-    upbuf_[i].blue = l;
-  }
-}
-*/
 
 
 
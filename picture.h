@@ -37,6 +37,14 @@
  *  @date 2021.4.29 v0.1
  *    LIBPOLYMNIAのRGB24bit畫像バッファクラスから改作
  *
+ *  @date 2026.10.17
+ *    バッファの先頭アドレスを整列させ、ピッチを整列單位に切り上げるやうに變更
+ *  @date 2026.10.17 外部の領域を用ゐるwrap()を追加
+ *  @date 2026.10.17 grayscale()を復活し、處理先を與へる函數を追加
+ *  @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ *  @date 2026.10.17 初期化方針を指定するcreate()を追加
+ *  @date 2026.10.17 變更範圍のみの擴大縮小を追加
+ *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_PICTURE_H
 #define INCLUDE_GUARD_EUNOMIA_PICTURE_H
@@ -44,6 +52,7 @@
 #include <memory>
 #include "imagebuffer.h"
 #include "colour.h"
+#include "pixelbuffer.h"
 
 
 namespace eunomia
@@ -59,29 +68,90 @@ class Picture : public ImageBuffer<RgbColour>
 {
 private:
   /// @brief 畫像バッファとして確保した領域の資源管理のためのunique_ptr
-  std::unique_ptr<RgbColour[]> upbuf_;
+  PixelBufferPtr upbuf_;
 
 protected:
   /// @brief 構築子
   /// @param w 畫像の幅
   /// @param h 畫像の高さ
-  Picture(unsigned w, unsigned h);
+  /// @param align ピッチの整列單位(バイト數)
+  /// @param init 初期化方針
+  Picture(unsigned w, unsigned h, int align, InitPolicy init);
+
+  /// @brief 構築子
+  ///
+  /// 外部の領域bufを畫像バッファとする。
+  /// 領域の所有權はwrap()で設定する。
+  /// @param buf 左上の畫素のアドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  Picture(std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept;
 
 public:
   /// @brief 畫像バッファ生成
   ///
   /// 幅と高さを指定してPictureオブジェクトを生成する。
+  /// バッファの先頭アドレスはBUFFER_ALIGNMENTに整列し、
+  /// ピッチはalignの倍數に切り上げられる。
+  /// 記憶領域は既定の確保器(defaultBufferAllocator())から確保する。
+  /// 幅または高さがintで表せない場合は失敗してnullptrを返す。
   /// @param w 畫像の幅
   /// @param h 畫像の高さ
-  static std::unique_ptr<Picture> create(unsigned w, unsigned h) noexcept;
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<Picture>
+  create(unsigned w, unsigned h, int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 畫像バッファ生成
+  ///
+  /// 初期化方針initを指定してオブジェクトを生成する。
+  /// InitPolicy::Uninitializedを指定した場合、
+  /// 畫素値は不定となるので、呼び出し側で全畫素を書き込まなければならない。
+  /// その他はcreate(w, h, align)と同じ。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<Picture>
+  create(
+    unsigned w, unsigned h, InitPolicy init,
+    int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 外部の領域を用ゐる畫像バッファ生成
+  ///
+  /// 外部で確保された領域bufを複製せずに畫像バッファとするPictureオブジェクトを
+  /// 生成する。生成したオブジェクトの全ての處理はbuf上で直接行はれる。
+  ///
+  /// deleterを與へた場合は領域の所有權を引き取り、
+  /// オブジェクトの破棄時にdeleter(buf)を呼び出す。
+  /// deleterが空の場合は領域を借用するのみで、
+  /// 呼び出し側はオブジェクトより長く領域を生存させなければならない。
+  /// 生成に失敗した場合はnullptrを返し、deleterは呼び出さない。
+  ///
+  /// pitchには任意の値を與へてよいが、その絶對値は
+  /// 1ライン分の畫素が占めるバイト數以上でなければならない。
+  /// 負の値を與へると、bufを最上ラインとする下から上への竝びになる。
+  ///
+  /// @param buf 左上の畫素のアドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  /// @param deleter 領域を解放する函數。空ならば借用。
+  static
+  std::unique_ptr<Picture>
+  wrap(
+    std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+    ExternalBufferDeleter deleter = nullptr) noexcept;
 
   /// @brief 複製
   std::unique_ptr<Picture> clone() const noexcept;
 
-  //// @brief グレイスケール化
-  ////
-  //// 自己の内容をグレイスケール化する。
-  //void grayscale() noexcept;
+  /// @brief グレイスケール化
+  ///
+  /// 自己の内容をグレイスケール化する。
+  void grayscale() noexcept;
 
   /// @brief グレイスケール化複製
   ///
@@ -115,6 +185,112 @@ public:
 };
 
 
+/// @brief 擴大
+///
+/// 畫像バッファsrcを擴大したPictureを生成する。
+/// srcにはImageView<RgbColour>などを與へてもよい。
+///
+/// @param src 擴大する畫像
+/// @param w 生成する畫像の幅
+/// @param h 生成する畫像の高さ
+/// @param a シャープネスを加減するパラメタ。Picture::magnify()に同じ。
+std::unique_ptr<Picture>
+magnify(
+  const ImageBuffer<RgbColour>& src, int w, int h, double a = -1.0) noexcept;
+
+/// @brief 縮小
+///
+/// 畫像バッファsrcを縮小したPictureを生成する。
+/// srcにはImageView<RgbColour>などを與へてもよい。
+///
+/// @param src 縮小する畫像
+/// @param w 生成する畫像の幅
+/// @param h 生成する畫像の高さ
+std::unique_ptr<Picture>
+reduce(const ImageBuffer<RgbColour>& src, int w, int h) noexcept;
+
+
+/// @brief 擴大先を與へる擴大
+///
+/// 畫像バッファsrcを、dstの幅と高さに擴大してdstに書き込む。
+/// 領域の確保を行はないので、同じ大きさの處理を反復するときに
+/// 同じdstを使ひ回すことができる。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 擴大する畫像
+/// @param dst 擴大先の畫像
+/// @param a シャープネスを加減するパラメタ。Picture::magnify()に同じ。
+void
+magnify(
+  const ImageBuffer<RgbColour>& src, ImageBuffer<RgbColour>& dst,
+  double a = -1.0) noexcept;
+
+/// @brief 縮小先を與へる縮小
+///
+/// 畫像バッファsrcを、dstの幅と高さに縮小してdstに書き込む。
+/// 領域の確保を行はない。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 縮小する畫像
+/// @param dst 縮小先の畫像
+void
+reduce(const ImageBuffer<RgbColour>& src, ImageBuffer<RgbColour>& dst) noexcept;
+
+/// @brief 變更範圍の擴大
+///
+/// srcのうちdamageの範圍のみが變更されたものとして、
+/// dstのうち影響を受ける部分のみを計算し直す。
+/// dstには、變更前のsrcをmagnify(src, dst, a)で擴大した結果が
+/// 入つてゐなければならない。
+/// 例へばsrc.damage()を與へ、その後にsrc.resetDamage()を呼ぶ。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 擴大する畫像
+/// @param dst 擴大先の畫像
+/// @param damage srcの變更範圍
+/// @param a シャープネスを加減するパラメタ。Picture::magnify()に同じ。
+void
+magnify(
+  const ImageBuffer<RgbColour>& src, ImageBuffer<RgbColour>& dst,
+  const DamageRegion& damage, double a = -1.0) noexcept;
+
+/// @brief 變更範圍の縮小
+///
+/// srcのうちdamageの範圍のみが變更されたものとして、
+/// dstのうち影響を受ける部分のみを計算し直す。
+/// dstには、變更前のsrcをreduce(src, dst)で縮小した結果が
+/// 入つてゐなければならない。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 縮小する畫像
+/// @param dst 縮小先の畫像
+/// @param damage srcの變更範圍
+void
+reduce(
+  const ImageBuffer<RgbColour>& src, ImageBuffer<RgbColour>& dst,
+  const DamageRegion& damage) noexcept;
+
+/// @brief グレイスケール化したインデックスカラーへの變換
+///
+/// srcをグレイスケール化してdstに書き込み、dstのパレットを設定する。
+/// 領域の確保を行はない。
+/// @return 成功すればtrue。srcとdstの幅または高さが異なればfalse。
+bool
+convertToGrayscaledIndexed(
+  const ImageBuffer<RgbColour>& src, PictureIndexed& dst) noexcept;
+
+/// @brief インデックスカラーへの變換(減色)
+///
+/// srcからパレットを生成し、誤差擴散法で減色してdstに書き込む。
+/// 誤差擴散用の作業領域(數ライン分)を一時的に確保する。
+/// @return
+///   成功すればtrue。
+///   srcとdstの幅または高さが異なるか、作業領域の確保に失敗すればfalse。
+bool
+convertToIndexed(const ImageBuffer<RgbColour>& src, PictureIndexed& dst)
+  noexcept;
+
+
 }// end of namespace eunomia
 
 
@@ -34,27 +34,55 @@
  *
  * @date 2021.4.24 LIBPOLYMNIAからLIBEUNOMIAに移植
  *
+ * @date 2026.10.17 整列したバッファの確保とピッチの切り上げに對應
+ * @date 2026.10.17 外部の領域を用ゐるwrap()を追加
+ * @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ * @date 2026.10.17 初期化方針を指定するcreate()を追加
+ *
  */
 
 #include <algorithm>
 #include <new>
+#include <utility>
 #include "picture_indexed.h"
 
 
-eunomia::PictureIndexed::PictureIndexed(unsigned w, unsigned h)
+eunomia::PictureIndexed::PictureIndexed(
+  unsigned w, unsigned h, int align, InitPolicy init)
   :
-  ImageBuffer<std::uint8_t>(w, h, sizeof(std::uint8_t) * w),
-  upbuf_(std::make_unique<std::uint8_t[]>(w * h))
+  ImageBuffer<std::uint8_t>(w, h, alignPitch(sizeof(std::uint8_t) * w, align)),
+  upbuf_(allocatePixelBuffer(bufferBytes(pitch_, h)))
 {
   buf_ = upbuf_.get();
+  if (init == InitPolicy::Initialized)
+    std::fill_n(buf_, bufferBytes(pitch_, h_), 0);
+}
+
+
+eunomia::PictureIndexed::PictureIndexed(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept
+  : ImageBuffer<std::uint8_t>(w, h, pitch)
+{
+  buf_ = buf;
+}
+
+
+std::unique_ptr<eunomia::PictureIndexed>
+eunomia::PictureIndexed::create(unsigned w, unsigned h, int align) noexcept
+{
+  return create(w, h, InitPolicy::Initialized, align);
 }
 
 
 std::unique_ptr<eunomia::PictureIndexed>
-eunomia::PictureIndexed::create(unsigned w, unsigned h) noexcept
+eunomia::PictureIndexed::create(
+  unsigned w, unsigned h, InitPolicy init, int align) noexcept
 {
+  if (align <= 0 || !isValidImageSize(w, h))
+    return nullptr;
+
   try {
-    return std::unique_ptr<PictureIndexed>(new PictureIndexed(w, h));
+    return std::unique_ptr<PictureIndexed>(new PictureIndexed(w, h, align, init));
   }
   catch(std::bad_alloc&) {
     return nullptr;
@@ -62,12 +90,35 @@ eunomia::PictureIndexed::create(unsigned w, unsigned h) noexcept
 }
 
 
+std::unique_ptr<eunomia::PictureIndexed>
+eunomia::PictureIndexed::wrap(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+  eunomia::ExternalBufferDeleter deleter) noexcept
+{
+  if (!buf || !isValidImageSize(w, h))
+    return nullptr;
+  auto rowbytes = static_cast<std::ptrdiff_t>(w * sizeof(std::uint8_t));
+  if ((pitch < 0 ? -pitch : pitch) < rowbytes)
+    return nullptr;
+
+  try {
+    std::unique_ptr<PictureIndexed> res(new PictureIndexed(buf, w, h, pitch));
+    res->upbuf_ = adoptPixelBuffer(buf, std::move(deleter));
+    return res;
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
 std::unique_ptr<eunomia::PictureIndexed>
 eunomia::PictureIndexed::clone() const noexcept
 {
-  auto res = create(w_, h_);
+  auto res = create(w_, h_, InitPolicy::Uninitialized);
   if (res) {
-    std::copy_n(buf_, h_ * pitch_, res->buf_);
+    for (int j = 0; j < h_; ++j)
+      std::copy_n(lineBuffer(j), w_, res->lineBuffer(j));
     std::copy_n(pal_, 256, res->pal_);
   }
   return res;
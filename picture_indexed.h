@@ -37,13 +37,25 @@
  *  @date 2021.4.29 v0.1
  *    LIBPOLYMNIAのRGB24bit256インデックス畫像バッファクラスから改作
  *
+ *  @date 2026.10.17
+ *    バッファの先頭アドレスを整列させ、ピッチを整列單位に切り上げるやうに變更
+ *  @date 2026.10.17 外部の領域を用ゐるwrap()を追加
+ *  @date 2026.10.17 處理先を與へるconvertToRgb()を追加
+ *  @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ *  @date 2026.10.17 初期化方針を指定するcreate()を追加
+ *  @date 2026.10.17
+ *    NormalBrendCopierFromPictureIndexedにパレットの表と1ライン單位の轉送を追加
+ *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_PICTURE_INDEXED_H
 #define INCLUDE_GUARD_EUNOMIA_PICTURE_INDEXED_H
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include "imagebuffer.h"
 #include "colour.h"
+#include "pixelbuffer.h"
 
 
 namespace eunomia
@@ -58,7 +70,7 @@ class PictureIndexed : public ImageBuffer<std::uint8_t>
 {
 private:
   /// @brief 畫像バッファとして確保した領域の資源管理のためのunique_ptr
-  std::unique_ptr<std::uint8_t[]> upbuf_;
+  PixelBufferPtr upbuf_;
 
 protected:
   RgbColour pal_[256]; ///< パレット
@@ -66,16 +78,76 @@ protected:
   /// @brief 構築子
   /// @param w 幅
   /// @param h 高さ
-  PictureIndexed(unsigned w, unsigned h);
+  /// @param align ピッチの整列單位(バイト數)
+  /// @param init 初期化方針
+  PictureIndexed(unsigned w, unsigned h, int align, InitPolicy init);
+
+  /// @brief 構築子
+  ///
+  /// 外部の領域bufを畫像バッファとする。
+  /// 領域の所有權はwrap()で設定する。
+  /// @param buf 左上の畫素のアドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  PictureIndexed(std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept;
 
 public:
   /// @brief 畫像バッファ生成
   ///
   /// 幅と高さを指定してPictureIndexedオブジェクトを生成する。
+  /// バッファの先頭アドレスはBUFFER_ALIGNMENTに整列し、
+  /// ピッチはalignの倍數に切り上げられる。
+  /// 記憶領域は既定の確保器(defaultBufferAllocator())から確保する。
+  /// 幅または高さがintで表せない場合は失敗してnullptrを返す。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<PictureIndexed>
+  create(unsigned w, unsigned h, int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 畫像バッファ生成
+  ///
+  /// 初期化方針initを指定してオブジェクトを生成する。
+  /// InitPolicy::Uninitializedを指定した場合、
+  /// 畫素値は不定となるので、呼び出し側で全畫素を書き込まなければならない。
+  /// その他はcreate(w, h, align)と同じ。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<PictureIndexed>
+  create(
+    unsigned w, unsigned h, InitPolicy init,
+    int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 外部の領域を用ゐる畫像バッファ生成
+  ///
+  /// 外部で確保された領域bufを複製せずに畫像バッファとするPictureIndexedオブジェクトを
+  /// 生成する。生成したオブジェクトの全ての處理はbuf上で直接行はれる。
+  ///
+  /// deleterを與へた場合は領域の所有權を引き取り、
+  /// オブジェクトの破棄時にdeleter(buf)を呼び出す。
+  /// deleterが空の場合は領域を借用するのみで、
+  /// 呼び出し側はオブジェクトより長く領域を生存させなければならない。
+  /// 生成に失敗した場合はnullptrを返し、deleterは呼び出さない。
+  ///
+  /// pitchには任意の値を與へてよいが、その絶對値は
+  /// 1ライン分の畫素が占めるバイト數以上でなければならない。
+  /// 負の値を與へると、bufを最上ラインとする下から上への竝びになる。
+  ///
+  /// @param buf 左上の畫素のアドレス
   /// @param w 幅
   /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  /// @param deleter 領域を解放する函數。空ならば借用。
   static
-  std::unique_ptr<PictureIndexed> create(unsigned w, unsigned h) noexcept;
+  std::unique_ptr<PictureIndexed>
+  wrap(
+    std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+    ExternalBufferDeleter deleter = nullptr) noexcept;
 
   /// @brief 複製
   std::unique_ptr<PictureIndexed> clone() const noexcept;
@@ -116,32 +188,63 @@ public:
  * PictureIndexed を 
  * ImageBuffer<RgbColour>::blt() あるいは ImageBuffer<RgbaColour>::blt()
  * の轉送元として、單純な轉寫を行ふ。
+ *
+ * 構築時にパレットを4バイト/色の表に寫し取り、以後はこれを引く。
+ * 從つて構築後のパレットの變更は反映されない。
+ * blt()からは1ライン單位の轉送が用ゐられる。
  */
 class NormalBrendCopierFromPictureIndexed
 {
 private:
-  const PictureIndexed& pi_;
+  /// パレットの各色をRgbaColour(アルファ値は255)のバイト列として詰めた表
+  std::uint32_t lut_[256];
+
+  RgbaColour colour_(std::uint8_t id) const noexcept
+  {
+    RgbaColour c;
+    std::memcpy(static_cast<void*>(&c), &lut_[id], sizeof(c));
+    return c;
+  }
 
 public:
   explicit
-  NormalBrendCopierFromPictureIndexed(const PictureIndexed& p) noexcept
-    : pi_(p)
-    {}
+  NormalBrendCopierFromPictureIndexed(const PictureIndexed& p) noexcept;
 
   void operator()(std::uint8_t src, RgbColour& dst) const noexcept
   {
-    dst = pi_.palette(src);
+    dst = static_cast<RgbColour>(colour_(src));
   }
 
   void operator()(std::uint8_t src, RgbaColour& dst) const noexcept
   {
-    dst.red = pi_.palette(src).red;
-    dst.green = pi_.palette(src).green;
-    dst.blue = pi_.palette(src).blue;
+    auto c = colour_(src);
+    dst.red = c.red;
+    dst.green = c.green;
+    dst.blue = c.blue;
+    // dst.alphaは變更しない
   }
+
+  /// @brief 1ライン分の轉送
+  ///
+  /// src[0]〜src[n-1]をパレットで展開してdst[0]〜dst[n-1]に轉送する。
+  /// 表引きをAVX2のgather、RGBへの詰め直しやアルファ値の保持を
+  /// SSE2、SSSE3で行へる場合はそれらを用ゐる。
+  /// 結果は一畫素づつ轉送した場合と一致する。
+  void
+  operator()(const std::uint8_t* src, RgbColour* dst, int n) const noexcept;
+  void
+  operator()(const std::uint8_t* src, RgbaColour* dst, int n) const noexcept;
 };
 
 
+/// @brief RGB24bitへの變換
+///
+/// srcの各畫素をパレットで展開してdstに書き込む。領域の確保を行はない。
+/// @return 成功すればtrue。srcとdstの幅または高さが異なればfalse。
+bool convertToRgb(const PictureIndexed& src, ImageBuffer<RgbColour>& dst)
+  noexcept;
+
+
 
 
 }// end of namespace eunomia
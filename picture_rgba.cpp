@@ -28,27 +28,81 @@
  * @file picture_rgba.cpp
  * @author oZ/acy
  *
+ * @date 2026.10.17 整列したバッファの確保とピッチの切り上げに對應
+ * @date 2026.10.17 外部の領域を用ゐるwrap()を追加
+ * @date 2026.10.17 ピッチを std::ptrdiff_t に變更
+ * @date 2026.10.17 初期化方針を指定するcreate()を追加
+ *
  */
 
 #include <algorithm>
 #include <new>
+#include <utility>
 #include "picture_rgba.h"
 
 
-eunomia::PictureRgba::PictureRgba(unsigned w, unsigned h)
+eunomia::PictureRgba::PictureRgba(
+  unsigned w, unsigned h, int align, InitPolicy init)
   : 
-  ImageBuffer<RgbaColour>(w, h, w * sizeof(RgbaColour)),
-  upbuf_(std::make_unique<RgbaColour[]>(w * h))
+  ImageBuffer<RgbaColour>(w, h, alignPitch(w * sizeof(RgbaColour), align)),
+  upbuf_(allocatePixelBuffer(bufferBytes(pitch_, h)))
+{
+  buf_ = upbuf_.get();
+
+  // 各畫素はRGBA(0, 0, 0, 255)、ライン末尾の詰め物は0で初期化する。
+  if (init == InitPolicy::Initialized) {
+    std::fill_n(buf_, bufferBytes(pitch_, h_), 0);
+    clear(RgbaColour());
+  }
+}
+
+
+eunomia::PictureRgba::PictureRgba(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept
+  : ImageBuffer<RgbaColour>(w, h, pitch)
 {
-  buf_ = reinterpret_cast<std::uint8_t*>(upbuf_.get());
+  buf_ = buf;
 }
 
 
 std::unique_ptr<eunomia::PictureRgba>
-eunomia::PictureRgba::create(unsigned w, unsigned h) noexcept
+eunomia::PictureRgba::create(unsigned w, unsigned h, int align) noexcept
 {
+  return create(w, h, InitPolicy::Initialized, align);
+}
+
+
+std::unique_ptr<eunomia::PictureRgba>
+eunomia::PictureRgba::create(
+  unsigned w, unsigned h, InitPolicy init, int align) noexcept
+{
+  if (align <= 0 || !isValidImageSize(w, h))
+    return nullptr;
+
+  try {
+    return std::unique_ptr<PictureRgba>(new PictureRgba(w, h, align, init));
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+std::unique_ptr<eunomia::PictureRgba>
+eunomia::PictureRgba::wrap(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+  eunomia::ExternalBufferDeleter deleter) noexcept
+{
+  if (!buf || !isValidImageSize(w, h))
+    return nullptr;
+  auto rowbytes = static_cast<std::ptrdiff_t>(w * sizeof(RgbaColour));
+  if ((pitch < 0 ? -pitch : pitch) < rowbytes)
+    return nullptr;
+
   try {
-    return std::unique_ptr<PictureRgba>(new PictureRgba(w, h));
+    std::unique_ptr<PictureRgba> res(new PictureRgba(buf, w, h, pitch));
+    res->upbuf_ = adoptPixelBuffer(buf, std::move(deleter));
+    return res;
   }
   catch (std::bad_alloc&) {
     return nullptr;
@@ -59,9 +113,10 @@ eunomia::PictureRgba::create(unsigned w, unsigned h) noexcept
 std::unique_ptr<eunomia::PictureRgba>
 eunomia::PictureRgba::clone() const noexcept
 {
-  auto res = create(w_, h_);
+  auto res = create(w_, h_, InitPolicy::Uninitialized);
   if (res)
-    std::copy_n(buf_, h_ * pitch_, res->buf_);
+    for (int j = 0; j < h_; ++j)
+      std::copy_n(lineBuffer(j), w_, res->lineBuffer(j));
   return res;
 }
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file picture_rgba_premul.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 乘算濟みアルファのRGBA32bitの畫像バッファクラスの實裝
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <new>
+#include <utility>
+#include "picture_rgba_premul.h"
+
+
+eunomia::PictureRgbaPremul::PictureRgbaPremul(
+  unsigned w, unsigned h, int align, InitPolicy init)
+  :
+  ImageBuffer<RgbaPremulColour>(
+    w, h, alignPitch(w * sizeof(RgbaPremulColour), align)),
+  upbuf_(allocatePixelBuffer(bufferBytes(pitch_, h)))
+{
+  buf_ = upbuf_.get();
+
+  // 各畫素はRGBA(0, 0, 0, 255)、ライン末尾の詰め物は0で初期化する。
+  if (init == InitPolicy::Initialized) {
+    std::fill_n(buf_, bufferBytes(pitch_, h_), 0);
+    clear(RgbaPremulColour());
+  }
+}
+
+
+eunomia::PictureRgbaPremul::PictureRgbaPremul(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept
+  : ImageBuffer<RgbaPremulColour>(w, h, pitch)
+{
+  buf_ = buf;
+}
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgbaPremul::create(unsigned w, unsigned h, int align) noexcept
+{
+  return create(w, h, InitPolicy::Initialized, align);
+}
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgbaPremul::create(
+  unsigned w, unsigned h, InitPolicy init, int align) noexcept
+{
+  if (align <= 0 || !isValidImageSize(w, h))
+    return nullptr;
+
+  try {
+    return
+      std::unique_ptr<PictureRgbaPremul>(
+        new PictureRgbaPremul(w, h, align, init));
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgbaPremul::wrap(
+  std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+  eunomia::ExternalBufferDeleter deleter) noexcept
+{
+  if (!buf || !isValidImageSize(w, h))
+    return nullptr;
+  auto rowbytes = static_cast<std::ptrdiff_t>(w * sizeof(RgbaPremulColour));
+  if ((pitch < 0 ? -pitch : pitch) < rowbytes)
+    return nullptr;
+
+  try {
+    std::unique_ptr<PictureRgbaPremul>
+      res(new PictureRgbaPremul(buf, w, h, pitch));
+    res->upbuf_ = adoptPixelBuffer(buf, std::move(deleter));
+    return res;
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+std::unique_ptr<eunomia::PictureRgbaPremul>
+eunomia::PictureRgbaPremul::clone() const noexcept
+{
+  auto res = create(w_, h_, InitPolicy::Uninitialized);
+  if (res)
+    for (int j = 0; j < h_; ++j)
+      std::copy_n(lineBuffer(j), w_, res->lineBuffer(j));
+  return res;
+}
+
+
+
+
+//eof
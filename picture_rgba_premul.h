@@ -0,0 +1,226 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file picture_rgba_premul.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 乘算濟みアルファのRGBA32bitの畫像バッファクラス
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_PICTURE_RGBA_PREMUL_H
+#define INCLUDE_GUARD_EUNOMIA_PICTURE_RGBA_PREMUL_H
+
+#include <memory>
+#include "imagebuffer.h"
+#include "colour.h"
+#include "pixelbuffer.h"
+
+
+namespace eunomia
+{
+  class PictureRgba;
+
+
+/**
+ * @brief 乘算濟みアルファのRGBA32bitの畫像バッファ
+ *
+ * 合成や擴大縮小を繰り返す場合は、PictureRgbaをこの形式に變換して處理し、
+ * 最後に乘算濟みでない形式に戻すとよい。
+ * αブレンドにはPremulBrendCopierを用ゐる。
+ */
+class PictureRgbaPremul : public ImageBuffer<RgbaPremulColour>
+{
+private:
+  /// @brief 畫像バッファとして確保した領域の資源管理のためのunique_ptr
+  PixelBufferPtr upbuf_;
+
+protected:
+  /// @brief 構築子
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param align ピッチの整列單位(バイト數)
+  /// @param init 初期化方針
+  PictureRgbaPremul(unsigned w, unsigned h, int align, InitPolicy init);
+
+  /// @brief 構築子
+  ///
+  /// 外部の領域bufを畫像バッファとする。
+  /// 領域の所有權はwrap()で設定する。
+  /// @param buf 左上の畫素のアドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  PictureRgbaPremul(
+    std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch) noexcept;
+
+public:
+  /// @brief 畫像バッファ生成
+  ///
+  /// 幅と高さを指定してPictureRgbaPremulオブジェクトを生成する。
+  /// 各畫素はRGBA(0, 0, 0, 255)で初期化する。
+  /// その他はPictureRgba::create()に同じ。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<PictureRgbaPremul>
+  create(unsigned w, unsigned h, int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 畫像バッファ生成
+  ///
+  /// 初期化方針initを指定してオブジェクトを生成する。
+  /// その他はcreate(w, h, align)と同じ。
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param init 初期化方針
+  /// @param align ピッチの整列單位(バイト數)。正の値でなければならない。
+  static
+  std::unique_ptr<PictureRgbaPremul>
+  create(
+    unsigned w, unsigned h, InitPolicy init,
+    int align = DEFAULT_PITCH_ALIGNMENT) noexcept;
+
+  /// @brief 外部の領域を用ゐる畫像バッファ生成
+  ///
+  /// PictureRgba::wrap()に同じ。
+  /// @param buf 左上の畫素のアドレス
+  /// @param w 幅
+  /// @param h 高さ
+  /// @param pitch ピッチ(バイト數)
+  /// @param deleter 領域を解放する函數。空ならば借用。
+  static
+  std::unique_ptr<PictureRgbaPremul>
+  wrap(
+    std::uint8_t* buf, unsigned w, unsigned h, std::ptrdiff_t pitch,
+    ExternalBufferDeleter deleter = nullptr) noexcept;
+
+  /// @brief 複製
+  std::unique_ptr<PictureRgbaPremul> clone() const noexcept;
+
+  /// @brief 乘算濟みでない形式への變換
+  ///
+  /// 乘算濟みでないPictureRgbaを生成する。
+  std::unique_ptr<PictureRgba> unpremultiplied() const noexcept;
+
+  /// @brief 擴大
+  ///
+  /// 擴大した複製を生成する。
+  /// @param w 複製畫像の幅
+  /// @param h 複製畫像の高さ
+  /// @param a シャープネスを加減するパラメタ。PictureRgba::magnify()に同じ。
+  std::unique_ptr<PictureRgbaPremul>
+  magnify(int w, int h, double a = -1.0) const noexcept;
+
+  /// @brief 縮小
+  ///
+  /// 縮小した複製を生成する。
+  std::unique_ptr<PictureRgbaPremul> reduce(int w, int h) const noexcept;
+};
+
+
+/// @brief 擴大
+///
+/// 畫像バッファsrcを擴大したPictureRgbaPremulを生成する。
+/// 各色要素はアルファ値を超えないやうに丸められる。
+///
+/// @param src 擴大する畫像
+/// @param w 生成する畫像の幅
+/// @param h 生成する畫像の高さ
+/// @param a シャープネスを加減するパラメタ。PictureRgba::magnify()に同じ。
+std::unique_ptr<PictureRgbaPremul>
+magnify(
+  const ImageBuffer<RgbaPremulColour>& src, int w, int h, double a = -1.0)
+  noexcept;
+
+/// @brief 縮小
+///
+/// 畫像バッファsrcを縮小したPictureRgbaPremulを生成する。
+///
+/// @param src 縮小する畫像
+/// @param w 生成する畫像の幅
+/// @param h 生成する畫像の高さ
+std::unique_ptr<PictureRgbaPremul>
+reduce(const ImageBuffer<RgbaPremulColour>& src, int w, int h) noexcept;
+
+
+/// @brief 擴大先を與へる擴大
+///
+/// 畫像バッファsrcを、dstの幅と高さに擴大してdstに書き込む。
+/// 領域の確保を行はない。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 擴大する畫像
+/// @param dst 擴大先の畫像
+/// @param a シャープネスを加減するパラメタ。PictureRgba::magnify()に同じ。
+void
+magnify(
+  const ImageBuffer<RgbaPremulColour>& src, ImageBuffer<RgbaPremulColour>& dst,
+  double a = -1.0) noexcept;
+
+/// @brief 縮小先を與へる縮小
+///
+/// 畫像バッファsrcを、dstの幅と高さに縮小してdstに書き込む。
+/// 領域の確保を行はない。
+/// srcとdstが同じ畫像バッファを指す場合、兩者の範圍が重なつてはならない。
+///
+/// @param src 縮小する畫像
+/// @param dst 縮小先の畫像
+void
+reduce(
+  const ImageBuffer<RgbaPremulColour>& src, ImageBuffer<RgbaPremulColour>& dst)
+  noexcept;
+
+
+/// @brief 乘算濟みアルファへの變換
+///
+/// srcの各畫素の色要素にアルファ値を乘じてdstに書き込む。
+/// 領域の確保を行はない。
+/// @return 成功すればtrue。srcとdstの幅または高さが異なればfalse。
+bool
+convertToPremul(
+  const ImageBuffer<RgbaColour>& src, ImageBuffer<RgbaPremulColour>& dst)
+  noexcept;
+
+/// @brief 乘算濟みでないアルファへの變換
+///
+/// srcの各畫素の色要素をアルファ値で除してdstに書き込む。
+/// 結果はRgbaPremulColourからRgbaColourへの變換に一致する。
+/// 領域の確保を行はない。
+/// @return 成功すればtrue。srcとdstの幅または高さが異なればfalse。
+bool
+convertToStraight(
+  const ImageBuffer<RgbaPremulColour>& src, ImageBuffer<RgbaColour>& dst)
+  noexcept;
+
+
+}// end of namespace eunomia
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_PICTURE_RGBA_PREMUL_H
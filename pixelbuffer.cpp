@@ -0,0 +1,134 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/*
+ * @file pixelbuffer.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの記憶領域の確保の實裝
+ *
+ * @date 2026.10.17 作成
+ * @date 2026.10.17 確保器(BufferAllocator)を差し替へ可能に
+ * @date 2026.10.17 外部の記憶領域の引き取りに對應
+ *
+ */
+#include <atomic>
+#include <new>
+#include <utility>
+#include "pixelbuffer.h"
+
+
+namespace
+{
+
+eunomia::AlignedBufferAllocator standardAllocator_;
+std::atomic<eunomia::BufferAllocator*> defaultAllocator_(&standardAllocator_);
+
+
+/// 外部の記憶領域を解放するための確保器
+///
+/// 引き取つた領域毎に生成し、解放時に自身も破棄する。
+class ExternalReleaser_ : public eunomia::BufferAllocator
+{
+private:
+  eunomia::ExternalBufferDeleter deleter_;
+
+public:
+  explicit ExternalReleaser_(eunomia::ExternalBufferDeleter&& deleter) noexcept
+    : deleter_(std::move(deleter))
+    {}
+
+  std::uint8_t* allocate(std::size_t /*size*/) override
+  {
+    throw std::bad_alloc();
+  }
+
+  void deallocate(std::uint8_t* p, std::size_t /*size*/) noexcept override
+  {
+    deleter_(p);
+    delete this;
+  }
+};
+
+}// end of NONAME namespace
+
+
+std::uint8_t* eunomia::AlignedBufferAllocator::allocate(std::size_t size)
+{
+  void* p = ::operator new[](size, std::align_val_t(BUFFER_ALIGNMENT));
+  return static_cast<std::uint8_t*>(p);
+}
+
+
+void
+eunomia::AlignedBufferAllocator::deallocate(
+  std::uint8_t* p, std::size_t /*size*/) noexcept
+{
+  ::operator delete[](p, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
+
+eunomia::BufferAllocator& eunomia::defaultBufferAllocator() noexcept
+{
+  return *defaultAllocator_.load(std::memory_order_acquire);
+}
+
+
+void eunomia::setDefaultBufferAllocator(eunomia::BufferAllocator* alloc) noexcept
+{
+  if (!alloc)
+    alloc = &standardAllocator_;
+  defaultAllocator_.store(alloc, std::memory_order_release);
+}
+
+
+eunomia::PixelBufferPtr eunomia::allocatePixelBuffer(std::size_t size)
+{
+  return allocatePixelBuffer(size, defaultBufferAllocator());
+}
+
+
+eunomia::PixelBufferPtr
+eunomia::allocatePixelBuffer(std::size_t size, eunomia::BufferAllocator& alloc)
+{
+  return PixelBufferPtr(alloc.allocate(size), PixelBufferDeleter(&alloc, size));
+}
+
+
+eunomia::PixelBufferPtr
+eunomia::adoptPixelBuffer(
+  std::uint8_t* p, eunomia::ExternalBufferDeleter deleter)
+{
+  if (!p || !deleter)
+    return PixelBufferPtr(p, PixelBufferDeleter());
+
+  auto releaser = new ExternalReleaser_(std::move(deleter));
+  return PixelBufferPtr(p, PixelBufferDeleter(releaser, 0));
+}
+
+
+
+
+//eof
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file pixelbuffer.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 畫像バッファの記憶領域の確保
+ *
+ * @date 2026.10.17 作成
+ * @date 2026.10.17 確保器(BufferAllocator)を差し替へ可能に
+ * @date 2026.10.17 外部の記憶領域の引き取りに對應
+ * @date 2026.10.17 大きさの檢査とバイト數の算出を追加
+ * @date 2026.10.17 初期化方針(InitPolicy)を追加
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_PIXEL_BUFFER_H
+#define INCLUDE_GUARD_EUNOMIA_PIXEL_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+
+
+namespace eunomia
+{
+
+/// @brief 畫像バッファの先頭アドレスの整列境界(バイト數)
+///
+/// キャッシュライン一本分に揃へる。
+inline constexpr std::size_t BUFFER_ALIGNMENT = 64;
+
+/// @brief ピッチの既定の整列單位(バイト數)
+inline constexpr int DEFAULT_PITCH_ALIGNMENT = 64;
+
+
+/// @brief 畫像バッファ生成時の初期化方針
+///
+/// 生成直後に全畫素を上書きすることが分かつてゐる場合
+/// (畫像の讀み込み、複製、擴大縮小の結果など)は、
+/// Uninitializedを指定して初期化の手間を省くことができる。
+enum class InitPolicy
+{
+  Initialized,   ///< 全畫素を既定の値で初期化する
+  Uninitialized, ///< 初期化しない。畫素値もライン末尾の詰め物も不定となる。
+};
+
+
+/// @brief ピッチの算出
+///
+/// 1ライン分のバイト數rowbytesをalignの倍數に切り上げる。
+/// @param rowbytes 1ライン分の畫素が占めるバイト數
+/// @param align 整列單位(バイト數)
+constexpr std::size_t alignPitch(std::size_t rowbytes, std::size_t align) noexcept
+{
+  return (rowbytes + align - 1) / align * align;
+}
+
+
+/// @brief 畫像の大きさの檢査
+///
+/// 幅と高さがともにintで表せる範圍にあるかを調べる。
+/// 座標はintで扱ふため、これを超える畫像は構築できない。
+constexpr bool isValidImageSize(unsigned w, unsigned h) noexcept
+{
+  constexpr unsigned maxsize = std::numeric_limits<int>::max();
+  return w <= maxsize && h <= maxsize;
+}
+
+
+/// @brief 畫像バッファのバイト數の算出
+///
+/// ピッチpitchで高さhの畫像バッファが占めるバイト數を求める。
+/// 結果がstd::size_tで表せない場合はstd::bad_allocを送出する。
+inline std::size_t bufferBytes(std::size_t pitch, std::size_t h)
+{
+  if (h != 0 && pitch > std::numeric_limits<std::size_t>::max() / h)
+    throw std::bad_alloc();
+  return pitch * h;
+}
+
+
+/**
+ * @brief 畫像バッファの記憶領域の確保器の基底クラス
+ *
+ * Picture::create()などが畫像バッファの記憶領域を確保する際に用ゐる。
+ * 派生クラスを定義してsetDefaultBufferAllocator()で設定することにより、
+ * 確保の方法を差し替へることができる。
+ */
+class BufferAllocator
+{
+public:
+  virtual ~BufferAllocator() = default;
+
+  /// @brief 確保
+  ///
+  /// 先頭アドレスがBUFFER_ALIGNMENTに整列した、
+  /// sizeバイト以上の領域を確保する。
+  /// 確保に失敗した場合はstd::bad_allocを投げる。
+  /// @param size 確保するバイト數
+  virtual std::uint8_t* allocate(std::size_t size) = 0;
+
+  /// @brief 解放
+  ///
+  /// allocate()で確保した領域を解放する。
+  /// @param p 解放する領域の先頭アドレス
+  /// @param size 確保時に指定したバイト數
+  virtual void deallocate(std::uint8_t* p, std::size_t size) noexcept = 0;
+};
+
+
+/**
+ * @brief 整列した領域を都度確保する確保器
+ *
+ * 既定の確保器。alignment付きのoperator new[]で領域を確保する。
+ */
+class AlignedBufferAllocator : public BufferAllocator
+{
+public:
+  std::uint8_t* allocate(std::size_t size) override;
+  void deallocate(std::uint8_t* p, std::size_t size) noexcept override;
+};
+
+
+/// @brief 既定の確保器の取得
+///
+/// setDefaultBufferAllocator()で設定された確保器を返す。
+/// 設定されてゐなければAlignedBufferAllocatorのオブジェクトを返す。
+BufferAllocator& defaultBufferAllocator() noexcept;
+
+/// @brief 既定の確保器の設定
+///
+/// 以後、Picture::create()などが用ゐる確保器を設定する。
+/// 設定した確保器は、それを用ゐて確保された全ての畫像バッファよりも
+/// 長く生存してゐなければならない。
+/// @param alloc 確保器。nullptrの場合は標準の確保器に戻す。
+void setDefaultBufferAllocator(BufferAllocator* alloc) noexcept;
+
+
+/**
+ * @brief 畫像バッファの記憶領域を解放する函數オブジェクトクラス
+ *
+ * 領域を確保した確保器とバイト數を保持し、解放時にそれを用ゐる。
+ */
+class PixelBufferDeleter
+{
+private:
+  BufferAllocator* alloc_; ///< 確保器
+  std::size_t size_;  ///< 確保したバイト數
+
+public:
+  PixelBufferDeleter() noexcept : alloc_(nullptr), size_(0) {}
+
+  PixelBufferDeleter(BufferAllocator* alloc, std::size_t size) noexcept
+    : alloc_(alloc), size_(size)
+    {}
+
+  void operator()(std::uint8_t* p) const noexcept
+  {
+    if (alloc_)
+      alloc_->deallocate(p, size_);
+  }
+};
+
+
+/// @brief 畫像バッファの記憶領域を管理するunique_ptr
+using PixelBufferPtr = std::unique_ptr<std::uint8_t[], PixelBufferDeleter>;
+
+
+/// @brief 畫像バッファの記憶領域の確保
+///
+/// 既定の確保器を用ゐて、
+/// 先頭アドレスがBUFFER_ALIGNMENTに整列した領域を確保する。
+/// 領域の内容は初期化されない。
+/// 確保に失敗した場合はstd::bad_allocを投げる。
+/// @param size 確保するバイト數
+PixelBufferPtr allocatePixelBuffer(std::size_t size);
+
+/// @brief 畫像バッファの記憶領域の確保
+///
+/// 確保器allocを用ゐて、
+/// 先頭アドレスがBUFFER_ALIGNMENTに整列した領域を確保する。
+/// 領域の内容は初期化されない。
+/// 確保に失敗した場合はstd::bad_allocを投げる。
+/// @param size 確保するバイト數
+/// @param alloc 確保器
+PixelBufferPtr allocatePixelBuffer(std::size_t size, BufferAllocator& alloc);
+
+
+/// @brief 外部の記憶領域を解放する函數の型
+using ExternalBufferDeleter = std::function<void(std::uint8_t*)>;
+
+/// @brief 外部の記憶領域の引き取り
+///
+/// 外部で確保された領域pを、deleterで解放するPixelBufferPtrに收める。
+/// deleterが空の場合は領域を借用するのみで、解放しない。
+/// 確保に失敗した場合はstd::bad_allocを投げる。
+/// このときdeleterは呼ばれず、領域の所有權は呼び出し側に殘る。
+/// @param p 領域の先頭アドレス
+/// @param deleter 領域を解放する函數
+PixelBufferPtr adoptPixelBuffer(std::uint8_t* p, ExternalBufferDeleter deleter);
+
+
+}// end of namespace eunomia
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_PIXEL_BUFFER_H
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file planar_convert.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ImageBufferPlanarと畫素を竝べた畫像バッファとの變換
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include "imagebuffer_planar.h"
+#include "picture.h"
+#include "picture_rgba.h"
+
+
+void
+eunomia::deinterleave(
+  const eunomia::ImageBuffer<eunomia::RgbColour>& src,
+  eunomia::ImageBufferPlanar<3>& dst) noexcept
+{
+  int w = std::min(src.width(), dst.width());
+  int h = std::min(src.height(), dst.height());
+
+  for (int y = 0; y < h; ++y) {
+    auto s = src.lineBuffer(y);
+    auto r = dst.lineBuffer(0, y);
+    auto g = dst.lineBuffer(1, y);
+    auto b = dst.lineBuffer(2, y);
+    for (int x = 0; x < w; ++x) {
+      r[x] = s[x].red;
+      g[x] = s[x].green;
+      b[x] = s[x].blue;
+    }
+  }
+}
+
+
+void
+eunomia::deinterleave(
+  const eunomia::ImageBuffer<eunomia::RgbaColour>& src,
+  eunomia::ImageBufferPlanar<4>& dst) noexcept
+{
+  int w = std::min(src.width(), dst.width());
+  int h = std::min(src.height(), dst.height());
+
+  for (int y = 0; y < h; ++y) {
+    auto s = src.lineBuffer(y);
+    auto r = dst.lineBuffer(0, y);
+    auto g = dst.lineBuffer(1, y);
+    auto b = dst.lineBuffer(2, y);
+    auto a = dst.lineBuffer(3, y);
+    for (int x = 0; x < w; ++x) {
+      r[x] = s[x].red;
+      g[x] = s[x].green;
+      b[x] = s[x].blue;
+      a[x] = s[x].alpha;
+    }
+  }
+}
+
+
+void
+eunomia::interleave(
+  const eunomia::ImageBufferPlanar<3>& src,
+  eunomia::ImageBuffer<eunomia::RgbColour>& dst) noexcept
+{
+  int w = std::min(src.width(), dst.width());
+  int h = std::min(src.height(), dst.height());
+
+  for (int y = 0; y < h; ++y) {
+    auto r = src.lineBuffer(0, y);
+    auto g = src.lineBuffer(1, y);
+    auto b = src.lineBuffer(2, y);
+    auto d = dst.lineBuffer(y);
+    for (int x = 0; x < w; ++x) {
+      d[x].red = r[x];
+      d[x].green = g[x];
+      d[x].blue = b[x];
+    }
+  }
+}
+
+
+void
+eunomia::interleave(
+  const eunomia::ImageBufferPlanar<4>& src,
+  eunomia::ImageBuffer<eunomia::RgbaColour>& dst) noexcept
+{
+  int w = std::min(src.width(), dst.width());
+  int h = std::min(src.height(), dst.height());
+
+  for (int y = 0; y < h; ++y) {
+    auto r = src.lineBuffer(0, y);
+    auto g = src.lineBuffer(1, y);
+    auto b = src.lineBuffer(2, y);
+    auto a = src.lineBuffer(3, y);
+    auto d = dst.lineBuffer(y);
+    for (int x = 0; x < w; ++x) {
+      d[x].red = r[x];
+      d[x].green = g[x];
+      d[x].blue = b[x];
+      d[x].alpha = a[x];
+    }
+  }
+}
+
+
+std::unique_ptr<eunomia::ImageBufferPlanar<3>>
+eunomia::createPlanar(const eunomia::ImageBuffer<eunomia::RgbColour>& src)
+  noexcept
+{
+  auto res
+    = ImageBufferPlanar<3>::create(
+        src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    deinterleave(src, *res);
+  return res;
+}
+
+
+std::unique_ptr<eunomia::ImageBufferPlanar<4>>
+eunomia::createPlanar(const eunomia::ImageBuffer<eunomia::RgbaColour>& src)
+  noexcept
+{
+  auto res
+    = ImageBufferPlanar<4>::create(
+        src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    deinterleave(src, *res);
+  return res;
+}
+
+
+std::unique_ptr<eunomia::Picture>
+eunomia::createPicture(const eunomia::ImageBufferPlanar<3>& src) noexcept
+{
+  auto res
+    = Picture::create(src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    interleave(src, *res);
+  return res;
+}
+
+
+std::unique_ptr<eunomia::PictureRgba>
+eunomia::createPictureRgba(const eunomia::ImageBufferPlanar<4>& src) noexcept
+{
+  auto res
+    = PictureRgba::create(src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    interleave(src, *res);
+  return res;
+}
+
+
+
+
+//eof
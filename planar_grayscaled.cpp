@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file planar_grayscaled.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ImageBufferPlanarのグレイスケール化
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include "imagebuffer_planar.h"
+
+
+template<int N_>
+void eunomia::grayscale(eunomia::ImageBufferPlanar<N_>& image) noexcept
+{
+  static_assert(N_ >= 3, "grayscale needs red, green and blue planes");
+
+  for (int y = 0; y < image.height(); ++y) {
+    std::uint8_t* r = image.lineBuffer(0, y);
+    std::uint8_t* g = image.lineBuffer(1, y);
+    std::uint8_t* b = image.lineBuffer(2, y);
+    for (int x = 0; x < image.width(); ++x) {
+      std::uint8_t l = r[x] * 0.2990 + g[x] * 0.5870 + b[x] * 0.1140;
+      r[x] = l;
+      g[x] = l;
+      b[x] = l;
+    }
+  }
+}
+
+
+template void eunomia::grayscale<3>(eunomia::ImageBufferPlanar<3>&) noexcept;
+template void eunomia::grayscale<4>(eunomia::ImageBufferPlanar<4>&) noexcept;
+
+
+
+
+//eof
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file planar_magnify.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ImageBufferPlanarの擴大處理 (biCubic法)
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <vector>
+#include "imagebuffer_planar.h"
+
+#include "pict_magnify_func.h"
+
+
+template<int N_>
+std::unique_ptr<eunomia::ImageBufferPlanar<N_>>
+eunomia::magnify(
+  const eunomia::ImageBufferPlanar<N_>& src, int w, int h, double a) noexcept
+{
+  using eunomia::implement_::fCubic_;
+
+  auto res = ImageBufferPlanar<N_>::create(w, h, InitPolicy::Uninitialized);
+  if (!res)
+    return nullptr;
+
+  int sw = src.width();
+  int sh = src.height();
+
+  // X方向、Y方向の擴大率の逆數
+  double nrx = (double)sw / (double)w;
+  double nry = (double)sh / (double)h;
+
+  try {
+    // 擴大畫像上の各Xに對應する原畫像上の近傍四點のX座標と重み
+    std::vector<int> px(4 * static_cast<std::size_t>(w));
+    std::vector<double> fx(4 * static_cast<std::size_t>(w));
+    for (int X = 0; X < w; X++) {
+      double x0 = X * nrx;
+      double dx = x0 - (int)x0;
+      auto k = 4 * static_cast<std::size_t>(X);
+
+      fx[k] = fCubic_(1.0 + dx, a);
+      fx[k + 1] = fCubic_(dx, a);
+      fx[k + 2] = fCubic_(1.0 - dx, a);
+      fx[k + 3] = fCubic_(2.0 - dx, a);
+
+      for (int i = 0; i < 4; i++)
+        px[k + i] = std::clamp((int)x0 - 1 + i, 0, sw - 1);
+    }
+
+    // 縱方向に補間した原畫像一ライン分
+    std::vector<double> tmp(sw);
+
+    for (int Y = 0; Y < h; Y++) { // Yは擴大畫像上のY座標
+      double y0 = Y * nry;        // Yに對應する原畫像上のY座標
+      double dy = y0 - (int)y0;   // その小數部分
+
+      double fy[4];
+      fy[0] = fCubic_(1.0 + dy, a);
+      fy[1] = fCubic_(dy, a);
+      fy[2] = fCubic_(1.0 - dy, a);
+      fy[3] = fCubic_(2.0 - dy, a);
+
+      int py[4]; // 原畫像上の近傍四點のY座標
+      for (int i = 0; i < 4; i++)
+        py[i] = std::clamp((int)y0 - 1 + i, 0, sh - 1);
+
+      for (int c = 0; c < N_; c++) {
+        const std::uint8_t* s0 = src.lineBuffer(c, py[0]);
+        const std::uint8_t* s1 = src.lineBuffer(c, py[1]);
+        const std::uint8_t* s2 = src.lineBuffer(c, py[2]);
+        const std::uint8_t* s3 = src.lineBuffer(c, py[3]);
+        for (int x = 0; x < sw; x++)
+          tmp[x] = fy[0] * s0[x] + fy[1] * s1[x] + fy[2] * s2[x] + fy[3] * s3[x];
+
+        std::uint8_t* d = res->lineBuffer(c, Y);
+        for (int X = 0; X < w; X++) {
+          const int* pp = &px[4 * static_cast<std::size_t>(X)];
+          const double* ff = &fx[4 * static_cast<std::size_t>(X)];
+          double v
+            = tmp[pp[0]] * ff[0] + tmp[pp[1]] * ff[1]
+              + tmp[pp[2]] * ff[2] + tmp[pp[3]] * ff[3];
+          d[X] = std::clamp(v, 0.0, 255.0);
+        }
+      }
+    }
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+
+  return res;
+}
+
+
+template
+std::unique_ptr<eunomia::ImageBufferPlanar<3>>
+eunomia::magnify<3>(const eunomia::ImageBufferPlanar<3>&, int, int, double)
+  noexcept;
+
+template
+std::unique_ptr<eunomia::ImageBufferPlanar<4>>
+eunomia::magnify<4>(const eunomia::ImageBufferPlanar<4>&, int, int, double)
+  noexcept;
+
+
+
+
+//eof
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file planar_reduce.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief ImageBufferPlanarの縮小處理 (面積平均法)
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "imagebuffer_planar.h"
+
+
+namespace
+{
+
+// 原畫像からはみ出す部分の第c面の値
+// RgbColour()、RgbaColour()に合はせ、アルファ面のみ255とする。
+constexpr std::uint8_t outside_(int c) noexcept
+{
+  return c == 3 ? 255 : 0;
+}
+
+}// end of NONAME namespace
+
+
+template<int N_>
+std::unique_ptr<eunomia::ImageBufferPlanar<N_>>
+eunomia::reduce(const eunomia::ImageBufferPlanar<N_>& src, int w, int h)
+  noexcept
+{
+  auto res = ImageBufferPlanar<N_>::create(w, h, InitPolicy::Uninitialized);
+  if (!res)
+    return nullptr;
+
+  int sw = src.width();
+  int sh = src.height();
+
+  // 元サイズ/縮小サイズ
+  double dw = (double)sw / (double)w;
+  double dh = (double)sh / (double)h;
+
+  try {
+    // 縮小畫像上の各Xに對應する原畫像上の範圍[xb, xe)と各畫素の重み
+    // 重みは xw[xo[X]] から xe[X] - xb[X] 個竝ぶ
+    std::vector<int> xb, xe;
+    std::vector<std::size_t> xo;
+    std::vector<double> xw, xs;
+    for (int X = 0; X < w; X++) {
+      double x1 = (double)X * dw;
+      double x2 = (double)(X + 1) * dw;
+      if (x2 > sw)
+        break;
+
+      int bx = (int)x1;
+      int ex = std::ceil(x2);
+      xb.push_back(bx);
+      xe.push_back(ex);
+      xo.push_back(xw.size());
+
+      double s = 0.0;
+      for (int x = bx; x < ex; ++x) {
+        double left = x < x1 ? x1 : x;
+        double right = x + 1 > x2 ? x2 : x + 1;
+        xw.push_back(right - left);
+        s += right - left;
+      }
+      xs.push_back(s);
+    }
+    int cols = xb.size();
+
+    // 縱方向に重み附きで足し合はせた原畫像一ライン分
+    // (Picture::reduce()とは加算の順序が異なり、結果が±1異なり得る)
+    std::vector<double> acc(sw);
+
+    for (int Y = 0; Y < h; Y++) { // Yは縮小畫像上の座標
+      // Yに對應する原畫像上の座標
+      double y1 = Y * dh;
+      double y2 = (Y + 1) * dh;
+      if (y2 > sh) {
+        // 原畫像からはみ出す部分はPicture::reduce()と同じ畫素値にしておく
+        for (; Y < h; Y++)
+          for (int c = 0; c < N_; c++)
+            std::fill_n(res->lineBuffer(c, Y), w, outside_(c));
+        break;
+      }
+
+      int by = (int)y1;
+      int ey = std::ceil(y2);
+
+      for (int c = 0; c < N_; c++) {
+        std::fill(acc.begin(), acc.end(), 0.0);
+        double ys = 0.0;
+        for (int y = by; y < ey; ++y) {
+          double top = y < y1 ? y1 : y;
+          double bottom = y + 1 > y2 ? y2 : y + 1;
+          double ph = bottom - top;
+          ys += ph;
+
+          const std::uint8_t* s = src.lineBuffer(c, y);
+          for (int x = 0; x < sw; ++x)
+            acc[x] += ph * s[x];
+        }
+
+        std::uint8_t* d = res->lineBuffer(c, Y);
+        for (int X = 0; X < cols; X++) {
+          const double* wt = &xw[xo[X]];
+          double v = 0.0;
+          for (int x = xb[X]; x < xe[X]; ++x)
+            v += *wt++ * acc[x];
+
+          double S = ys * xs[X];
+          d[X] = S == 0.0 ? 0 : (std::uint8_t)(v / S + 0.5);
+        }
+        std::fill(d + cols, d + w, outside_(c));
+      }
+    }
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+
+  return res;
+}
+
+
+template
+std::unique_ptr<eunomia::ImageBufferPlanar<3>>
+eunomia::reduce<3>(const eunomia::ImageBufferPlanar<3>&, int, int) noexcept;
+
+template
+std::unique_ptr<eunomia::ImageBufferPlanar<4>>
+eunomia::reduce<4>(const eunomia::ImageBufferPlanar<4>&, int, int) noexcept;
+
+
+
+
+//eof
@@ -30,6 +30,7 @@
  * @brief PNG形式畫像ファイルの讀み込み
  *
  * @date 2021.4.29 v0.1 LIBPOLYMNIAのPNG讀み込み處理から改作
+ * @date 2026.10.17 讀み込み先の畫像を初期化せずに生成するやうに變更
  */
 #include <iostream>
 #include <fstream>
@@ -168,7 +169,9 @@ loadPngPictureIndexed_(
   // ここまで設定した入力変換を反映させる
   png_read_update_info(ppng, ppnginfo);
 
-  upindx = eunomia::PictureIndexed::create(width, height);
+  upindx
+    = eunomia::PictureIndexed::create(
+        width, height, eunomia::InitPolicy::Uninitialized);
   if (!upindx)
     throw PngReadException_();
 
@@ -209,7 +212,9 @@ loadPngPicture_(
   // ここまで設定した入力変換を反映させる
   png_read_update_info(ppng, ppnginfo);
 
-  uppict = eunomia::Picture::create(width, height);
+  uppict
+    = eunomia::Picture::create(
+        width, height, eunomia::InitPolicy::Uninitialized);
   if (!uppict)
     throw PngReadException_();
 
@@ -234,7 +239,9 @@ loadPngPictureRgba_(
   // ここまで設定した入力変換を反映させる
   png_read_update_info(ppng, ppnginfo);
 
-  uprgba = eunomia::PictureRgba::create(width, height);
+  uprgba
+    = eunomia::PictureRgba::create(
+        width, height, eunomia::InitPolicy::Uninitialized);
   if (!uprgba)
     throw PngReadException_();
 
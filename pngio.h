@@ -31,12 +31,15 @@
  *
  *  @date 2021.4.29 v0.1
  *  @date 2021.11.23 PictureIndexed向けのsavePng()の仕樣を變更
+ *  @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
+ *  @date 2026.10.17 變更範圍のみを保存するsavePng()を追加
  *
  */
 #ifndef INCLUDE_GUARD_EUNOMIA_PNG_INPUT_OUTPUT_H
 #define INCLUDE_GUARD_EUNOMIA_PNG_INPUT_OUTPUT_H
 
 #include <filesystem>
+#include "imageview.h"
 #include "picture.h"
 #include "picture_rgba.h"
 #include "picture_indexed.h"
@@ -74,22 +77,76 @@ bool loadPng(
  * @brief PNGファイルの保存
  *
  * 畫像をPNG形式で保存する。
+ * PictureのほかImageView<RgbColour>なども保存できる。
  * @param path 保存すべきPNGファイルのパス
  * @param pict 保存する畫像
  * @return 成功時にはtrue、さもなくばfalseを返す。
  */
-bool savePng(const Picture& pict, const std::filesystem::path& path);
+bool
+savePng(const ImageBuffer<RgbColour>& pict, const std::filesystem::path& path);
 
 /**
  * @brief PNGファイルの保存
  *
  * 畫像をPNG形式で保存する。
+ * PictureRgbaのほかImageView<RgbaColour>なども保存できる。
+ * @param pict 保存する畫像
+ * @param path 保存すべきPNGファイルのパス
+ * @return 成功時にはtrue、さもなくばfalseを返す。
+ */
+bool
+savePng(
+  const ImageBuffer<RgbaColour>& pict, const std::filesystem::path& path);
+
+/**
+ * @brief 變更範圍のPNGファイルへの保存
+ *
+ * 畫像のうちdamageの範圍の外接長方形のみをPNG形式で保存する。
+ * PNGは畫像全體を一續きに壓縮するため、一部のみを符號化し直して
+ * 既存のファイルに反映させることはできない。
+ * そこで變更された部分を切り出して保存し、差分として扱へるやうにする。
+ * 切り出した位置はdamage.bounds()の左上である。
+ * damageが空の場合は何も保存せずにfalseを返す。
+ * @param pict 保存する畫像
+ * @param damage 保存する範圍。pict.damage()など。
+ * @param path 保存すべきPNGファイルのパス
+ * @return 成功時にはtrue、さもなくばfalseを返す。
+ */
+inline
+bool
+savePng(
+  const ImageBuffer<RgbColour>& pict, const DamageRegion& damage,
+  const std::filesystem::path& path)
+{
+  if (damage.empty())
+    return false;
+  return
+    savePng(
+      ConstImageView<RgbColour>(pict, damage.bounds()).image(), path);
+}
+
+/**
+ * @brief 變更範圍のPNGファイルへの保存
+ *
+ * 畫像のうちdamageの範圍の外接長方形のみをPNG形式で保存する。
+ * ImageBuffer<RgbColour>版に同じ。
  * @param pict 保存する畫像
+ * @param damage 保存する範圍。pict.damage()など。
  * @param path 保存すべきPNGファイルのパス
  * @return 成功時にはtrue、さもなくばfalseを返す。
  */
+inline
 bool
-savePng(const PictureRgba& pict, const std::filesystem::path& path);
+savePng(
+  const ImageBuffer<RgbaColour>& pict, const DamageRegion& damage,
+  const std::filesystem::path& path)
+{
+  if (damage.empty())
+    return false;
+  return
+    savePng(
+      ConstImageView<RgbaColour>(pict, damage.bounds()).image(), path);
+}
 
 /**
  * @brief PNGファイルの保存
@@ -106,6 +163,24 @@ savePng(
   const PictureIndexed& pict, const std::filesystem::path& path,
   bool trns = false, std::uint8_t tpal = 0);
 
+/**
+ * @brief PNGファイルの保存
+ *
+ * インデックスカラーの畫像を、パレットを別途指定してPNG形式で保存する。
+ * PictureIndexedの部分畫像(ImageView<std::uint8_t>)などを保存するのに用ゐる。
+ * @param pict 保存する畫像
+ * @param palette 要素數256のパレット
+ * @param path 保存すべきPNGファイルのパス
+ * @param trns 透過色を用ゐる場合はtrue、さもなくばfalseを指定する。
+ * @param tpal 透過色とするパレットの番號
+ * @return 成功時にはtrue、さもなくばfalseを返す。
+ */
+bool
+savePng(
+  const ImageBuffer<std::uint8_t>& pict, const RgbColour palette[],
+  const std::filesystem::path& path,
+  bool trns = false, std::uint8_t tpal = 0);
+
 
 }// end of namespace eunomia
 
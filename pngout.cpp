@@ -31,6 +31,7 @@
  *
  * @date 2021.4.26 LIBPOLYMNIAのPNG書き込み處理から改作
  * @date 2021.11.23 PictureIndexed向けのsavePng()の仕樣を變更
+ * @date 2026.10.17 ImageBuffer<>(ImageView<>など)を保存できるやうに變更
  *
  */
 #include <iostream>
@@ -97,7 +98,8 @@ bool pngWriteInit_(std::ostream& os, png_structp& ppng, png_infop& ppnginfo)
 
 bool
 eunomia::savePng(
-  const eunomia::Picture& pict, const std::filesystem::path& path)
+  const eunomia::ImageBuffer<eunomia::RgbColour>& pict,
+  const std::filesystem::path& path)
 {
   std::ofstream ofs(path, std::ios::out | std::ios::binary);
   if (!ofs)
@@ -141,7 +143,8 @@ eunomia::savePng(
 
 bool
 eunomia::savePng(
-  const eunomia::PictureRgba& pict, const std::filesystem::path& path)
+  const eunomia::ImageBuffer<eunomia::RgbaColour>& pict,
+  const std::filesystem::path& path)
 {
   std::ofstream ofs(path, std::ios::out | std::ios::binary);
   if (!ofs)
@@ -187,6 +190,17 @@ bool
 eunomia::savePng(
   const eunomia::PictureIndexed& pict, const std::filesystem::path& path,
   bool trns, std::uint8_t tpal)
+{
+  return savePng(pict, pict.paletteBuffer(), path, trns, tpal);
+}
+
+
+bool
+eunomia::savePng(
+  const eunomia::ImageBuffer<std::uint8_t>& pict,
+  const eunomia::RgbColour palette[],
+  const std::filesystem::path& path,
+  bool trns, std::uint8_t tpal)
 {
   std::ofstream ofs(path, std::ios::out | std::ios::binary);
   if (!ofs)
@@ -208,13 +222,13 @@ eunomia::savePng(
     PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
   // パレットの設定
-  auto palette = std::make_unique<png_color[]>(256);
+  auto pngpal = std::make_unique<png_color[]>(256);
   for (int i = 0; i < 256; i++) {
-    palette[i].red = pict.palette(i).red;
-    palette[i].green = pict.palette(i).green;
-    palette[i].blue = pict.palette(i).blue;
+    pngpal[i].red = palette[i].red;
+    pngpal[i].green = palette[i].green;
+    pngpal[i].blue = palette[i].blue;
   }
-  png_set_PLTE(ppng, ppnginfo, palette.get(), 256);
+  png_set_PLTE(ppng, ppnginfo, pngpal.get(), 256);
 
   //透過処理
   auto transbf = std::make_unique<png_byte[]>(256);
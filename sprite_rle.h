@@ -0,0 +1,270 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file sprite_rle.h
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief 透明な畫素を連長壓縮したスプライト
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#ifndef INCLUDE_GUARD_EUNOMIA_SPRITE_RLE_H
+#define INCLUDE_GUARD_EUNOMIA_SPRITE_RLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <vector>
+#include "imagebuffer.h"
+#include "noncopyable.h"
+
+
+namespace eunomia
+{
+
+/**
+ * @brief 透明な畫素を連長壓縮したスプライト
+ *
+ * 畫像バッファから一度だけ構築し、各ラインの透明でない畫素の連(ラン)と
+ * その畫素値を保持する。
+ * ImageBuffer::blt()にこれを與へると、連の畫素のみを轉送し、
+ * 透明な畫素は讀みもしない。
+ * 大部分が透明なスプライトの轉送を大幅に速くすることを意圖してゐる。
+ *
+ * 連には不透明な畫素のみから成るものと、
+ * 半透明な畫素のみから成るものとがある。
+ * カラーキーで構築した場合は全ての連が不透明となる。
+ */
+template<class C_>
+class SpriteRle : Noncopyable<SpriteRle<C_>>
+{
+public:
+  typedef C_ ColourType;
+
+  /// @brief 連
+  struct Run
+  {
+    int x;               ///< 左端のX座標
+    int length;          ///< 畫素數
+    std::size_t offset;  ///< 畫素値の格納位置
+    bool opaque;         ///< 不透明な畫素の連ならばtrue
+  };
+
+private:
+  int w_;  ///< 幅
+  int h_;  ///< 高さ
+  std::vector<C_> pixels_;        ///< 全ての連の畫素値
+  std::vector<Run> runs_;         ///< 全ての連
+  std::vector<std::size_t> rows_; ///< ライン毎の連の開始位置(h_ + 1個)
+
+  SpriteRle(int w, int h) : w_(w), h_(h) {}
+
+  /// @brief 構築
+  ///
+  /// classify(p)は畫素pが透明ならば0、半透明ならば1、不透明ならば2を返す。
+  template<class Classify>
+  void build_(const ImageBuffer<C_>& src, Classify classify);
+
+  template<class Classify>
+  static
+  std::unique_ptr<SpriteRle>
+  create_(const ImageBuffer<C_>& src, Classify classify) noexcept;
+
+public:
+  /// @brief カラーキーによるスプライト生成
+  ///
+  /// srcの畫素のうちkeyに等しいものを透明とする。
+  /// 記憶領域の確保に失敗した場合はnullptrを返す。
+  /// @param src 元畫像
+  /// @param key 透明色
+  static
+  std::unique_ptr<SpriteRle>
+  createWithColourKey(const ImageBuffer<C_>& src, const C_& key) noexcept
+  {
+    return
+      create_(src, [&key](const C_& p) { return p == key ? 0 : 2; });
+  }
+
+  /// @brief アルファ値によるスプライト生成
+  ///
+  /// srcの畫素のうちアルファ値がthreshold以下のものを透明とし、
+  /// 255のものを不透明、その他を半透明とする。
+  /// C_が公開メンバ變數alphaを持つ場合にのみ用ゐることができる。
+  /// 記憶領域の確保に失敗した場合はnullptrを返す。
+  /// @param src 元畫像
+  /// @param threshold 透明とみなすアルファ値の上限
+  static
+  std::unique_ptr<SpriteRle>
+  createWithAlpha(const ImageBuffer<C_>& src, std::uint8_t threshold = 0)
+    noexcept
+    requires requires(C_ c) { c.alpha; }
+  {
+    return
+      create_(
+        src,
+        [threshold](const C_& p) {
+          return p.alpha <= threshold ? 0 : p.alpha == 255 ? 2 : 1;
+        });
+  }
+
+  /// @brief 幅
+  int width() const noexcept { return w_; }
+  /// @brief 高さ
+  int height() const noexcept { return h_; }
+
+  /// @brief Y座標yのラインの連
+  ///
+  /// 連はX座標の昇順に竝ぶ。
+  std::span<const Run> runs(int y) const noexcept
+  {
+    return
+      std::span<const Run>(runs_.data() + rows_[y], rows_[y + 1] - rows_[y]);
+  }
+
+  /// @brief 連の畫素値
+  const C_* pixels(const Run& run) const noexcept
+  {
+    return pixels_.data() + run.offset;
+  }
+
+  /// @brief 保持してゐる畫素の總數
+  std::size_t pixelCount() const noexcept { return pixels_.size(); }
+};
+
+
+}//end of namespace eunomia
+
+
+
+
+template<class C_> template<class Classify>
+inline
+void
+eunomia::SpriteRle<C_>::build_(
+  const eunomia::ImageBuffer<C_>& src, Classify classify)
+{
+  rows_.reserve(h_ + 1);
+  rows_.push_back(0);
+
+  for (int y = 0; y < h_; ++y) {
+    const C_* line = src.lineBuffer(y);
+    int x = 0;
+    while (x < w_) {
+      int kind = classify(line[x]);
+      int e = x + 1;
+      while (e < w_ && classify(line[e]) == kind)
+        ++e;
+
+      if (kind != 0) {
+        runs_.push_back(Run{x, e - x, pixels_.size(), kind == 2});
+        pixels_.insert(pixels_.end(), line + x, line + e);
+      }
+      x = e;
+    }
+    rows_.push_back(runs_.size());
+  }
+
+  pixels_.shrink_to_fit();
+  runs_.shrink_to_fit();
+}
+
+
+template<class C_> template<class Classify>
+inline
+std::unique_ptr<eunomia::SpriteRle<C_>>
+eunomia::SpriteRle<C_>::create_(
+  const eunomia::ImageBuffer<C_>& src, Classify classify) noexcept
+{
+  try {
+    std::unique_ptr<SpriteRle> res(new SpriteRle(src.width(), src.height()));
+    res->build_(src, classify);
+    return res;
+  }
+  catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+template<class C_> template<class CSrc, class OpaqueCopier, class Copier>
+inline
+void
+eunomia::ImageBuffer<C_>::blt(
+  const eunomia::SpriteRle<CSrc>& src, int dx, int dy,
+  const std::optional<eunomia::Rect>& cliprect,
+  OpaqueCopier opaque, Copier copier)
+{
+  using Coord = long long;
+
+  // 轉送先の變更してよい範圍
+  Coord left = 0, top = 0, right = w_, bottom = h_;
+  if (cliprect) {
+    left = std::max<Coord>(left, cliprect->left);
+    top = std::max<Coord>(top, cliprect->top);
+    right = std::min<Coord>(right, cliprect->right);
+    bottom = std::min<Coord>(bottom, cliprect->bottom);
+  }
+
+  int jb = static_cast<int>(std::clamp<Coord>(top - dy, 0, src.height()));
+  int je = static_cast<int>(std::clamp<Coord>(bottom - dy, 0, src.height()));
+
+  damaged_(
+    static_cast<int>(std::max<Coord>(dx, left)), dy + jb,
+    static_cast<int>(std::min<Coord>(Coord(dx) + src.width(), right)),
+    dy + je);
+
+  for (int j = jb; j < je; ++j) {
+    C_* line = lineBuffer(dy + j);
+
+    for (const auto& run : src.runs(j)) {
+      Coord x0 = Coord(dx) + run.x;
+      if (x0 >= right)
+        break;
+      Coord l = std::max(x0, left);
+      Coord r = std::min(x0 + run.length, right);
+      if (l >= r)
+        continue;
+
+      const CSrc* sp = src.pixels(run) + (l - x0);
+      C_* dp = line + l;
+      int n = static_cast<int>(r - l);
+      if (run.opaque)
+        implement_::copyRow_(opaque, sp, dp, n);
+      else
+        implement_::copyRow_(copier, sp, dp, n);
+    }
+  }
+}
+
+
+
+
+#endif // INCLUDE_GUARD_EUNOMIA_SPRITE_RLE_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file tiled_convert.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief TiledImageBufferから線形配置の畫像バッファへの變換
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include "imagebuffer_tiled.h"
+#include "picture.h"
+#include "picture_rgba.h"
+
+
+std::unique_ptr<eunomia::Picture>
+eunomia::createPicture(const eunomia::TiledImageBuffer<eunomia::RgbColour>& src)
+  noexcept
+{
+  auto res
+    = Picture::create(src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    untile(src, *res);
+  return res;
+}
+
+
+std::unique_ptr<eunomia::PictureRgba>
+eunomia::createPictureRgba(
+  const eunomia::TiledImageBuffer<eunomia::RgbaColour>& src) noexcept
+{
+  auto res
+    = PictureRgba::create(src.width(), src.height(), InitPolicy::Uninitialized);
+  if (res)
+    untile(src, *res);
+  return res;
+}
+
+
+
+
+//eof
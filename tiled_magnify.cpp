@@ -0,0 +1,162 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file tiled_magnify.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief TiledImageBufferの擴大處理 (biCubic法)
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <type_traits>
+#include "imagebuffer_tiled.h"
+
+#include "pict_magnify_func.h"
+
+
+namespace
+{
+
+// 擴大先のタイル毎に、Picture::magnify()と同じ計算を行ふ
+template<class C_>
+std::unique_ptr<eunomia::TiledImageBuffer<C_>>
+magnify_(
+  const eunomia::TiledImageBuffer<C_>& src, int w, int h, double a) noexcept
+{
+  using eunomia::implement_::fCubic_;
+  using eunomia::implement_::innerProduct_;
+  using eunomia::implement_::productMat14_44_;
+  using Tiled = eunomia::TiledImageBuffer<C_>;
+
+  constexpr bool hasAlpha = std::is_same_v<C_, eunomia::RgbaColour>;
+  constexpr int N = hasAlpha ? 4 : 3;
+
+  auto res = Tiled::create(w, h, eunomia::InitPolicy::Uninitialized);
+  if (!res)
+    return nullptr;
+
+  // X方向、Y方向の擴大率の逆數
+  double nrx = (double)src.width() / (double)w;
+  double nry = (double)src.height() / (double)h;
+
+  for (int ty = 0; ty < res->tileRows(); ++ty) {
+    int Y0 = ty << Tiled::TILE_SHIFT;
+    int nY = std::min(Tiled::TILE_SIZE, h - Y0);
+
+    for (int tx = 0; tx < res->tileColumns(); ++tx) {
+      int X0 = tx << Tiled::TILE_SHIFT;
+      int nX = std::min(Tiled::TILE_SIZE, w - X0);
+
+      // タイル内の各列について、原畫像上の近傍四點のX座標と重み
+      double fx[Tiled::TILE_SIZE][4];
+      int px[Tiled::TILE_SIZE][4];
+      for (int i = 0; i < nX; ++i) {
+        double x0 = (X0 + i) * nrx;
+        double dx = x0 - (int)x0;
+
+        fx[i][0] = fCubic_(1.0 + dx, a);
+        fx[i][1] = fCubic_(dx, a);
+        fx[i][2] = fCubic_(1.0 - dx, a);
+        fx[i][3] = fCubic_(2.0 - dx, a);
+
+        for (int k = 0; k < 4; k++)
+          px[i][k] = std::clamp((int)x0 - 1 + k, 0, src.width() - 1);
+      }
+
+      for (int j = 0; j < nY; ++j) {
+        double y0 = (Y0 + j) * nry;
+        double dy = y0 - (int)y0;
+
+        double fy[4];
+        fy[0] = fCubic_(1.0 + dy, a);
+        fy[1] = fCubic_(dy, a);
+        fy[2] = fCubic_(1.0 - dy, a);
+        fy[3] = fCubic_(2.0 - dy, a);
+
+        int py[4];
+        for (int k = 0; k < 4; k++)
+          py[k] = std::clamp((int)y0 - 1 + k, 0, src.height() - 1);
+
+        C_* d = res->tileLine(tx, ty, j);
+        for (int i = 0; i < nX; ++i) {
+          double buf[N][16];  // 近傍十六點の各チャネルの値を入れる4*4行列
+          for (int ii = 0; ii < 4; ii++)
+            for (int jj = 0; jj < 4; jj++) {
+              const C_& p = src.pixel(px[i][ii], py[jj]);
+              buf[0][ii + jj * 4] = p.red;
+              buf[1][ii + jj * 4] = p.green;
+              buf[2][ii + jj * 4] = p.blue;
+              if constexpr (hasAlpha)
+                buf[3][ii + jj * 4] = p.alpha;
+            }
+
+          double v[N];
+          for (int c = 0; c < N; c++) {
+            double tmp[4];
+            productMat14_44_(tmp, fy, buf[c]);
+            v[c] = std::clamp(innerProduct_(4, tmp, fx[i]), 0.0, 255.0);
+          }
+
+          d[i].red = v[0];
+          d[i].green = v[1];
+          d[i].blue = v[2];
+          if constexpr (hasAlpha)
+            d[i].alpha = v[3];
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
+
+}// end of NONAME namespace
+
+
+std::unique_ptr<eunomia::TiledImageBuffer<eunomia::RgbColour>>
+eunomia::magnify(
+  const eunomia::TiledImageBuffer<eunomia::RgbColour>& src,
+  int w, int h, double a) noexcept
+{
+  return magnify_(src, w, h, a);
+}
+
+
+std::unique_ptr<eunomia::TiledImageBuffer<eunomia::RgbaColour>>
+eunomia::magnify(
+  const eunomia::TiledImageBuffer<eunomia::RgbaColour>& src,
+  int w, int h, double a) noexcept
+{
+  return magnify_(src, w, h, a);
+}
+
+
+
+
+//eof
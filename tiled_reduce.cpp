@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026 oZ/acy (名賀月晃嗣)
+ * Redistribution and use in source and binary forms, 
+ *     with or without modification, 
+ *   are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file tiled_reduce.cpp
+ * @author oZ/acy (名賀月晃嗣)
+ * @brief TiledImageBufferの縮小處理 (面積平均法)
+ *
+ * @date 2026.10.17 作成
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include "imagebuffer_tiled.h"
+
+
+namespace
+{
+
+// 元畫像の(x1, y1)-(x2, y2)を一點に「凝縮」する
+// pict_reduce.cppのcondense_()と同じ計算を行ふ
+template<class C_>
+C_
+condense_(
+  const eunomia::TiledImageBuffer<C_>& src,
+  double x1, double y1, double x2, double y2)
+{
+  constexpr bool hasAlpha = std::is_same_v<C_, eunomia::RgbaColour>;
+
+  // 領域のbeginとendになる座標
+  int bx = (int)x1;
+  int by = (int)y1;
+  int ex = std::ceil(x2);
+  int ey = std::ceil(y2);
+
+  double S = 0.0;  // 總面積
+  double R = 0.0;
+  double G = 0.0;
+  double B = 0.0;
+  double A = 0.0;
+
+  for (int y = by; y < ey; ++y) {
+    double top = y < y1 ? y1 : y;
+    double bottom = y + 1 > y2 ? y2 : y + 1;
+    double ph = bottom - top;  // 高さ
+
+    for (int x = bx; x < ex; ++x) {
+      double left = x < x1 ? x1 : x;
+      double right = x + 1 > x2 ? x2 : x + 1;
+      double pw = right - left;  // 幅
+
+      double ss = ph * pw;  // 今回調べてゐる部分の面積
+      S += ss;
+
+      const C_& p = src.pixel(x, y);
+      R += ss * p.red;
+      G += ss * p.green;
+      B += ss * p.blue;
+      if constexpr (hasAlpha)
+        A += ss * p.alpha;
+    }
+  }
+
+  C_ res;
+  if (S == 0.0) {
+    res.red = res.green = res.blue = 0;
+    if constexpr (hasAlpha)
+      res.alpha = 0;
+  }
+  else {
+    res.red = (std::uint8_t)(R / S + 0.5);
+    res.green = (std::uint8_t)(G / S + 0.5);
+    res.blue = (std::uint8_t)(B / S + 0.5);
+    if constexpr (hasAlpha)
+      res.alpha = (std::uint8_t)(A / S + 0.5);
+  }
+  return res;
+}
+
+
+// 縮小先のタイル毎に、Picture::reduce()と同じ計算を行ふ
+template<class C_>
+std::unique_ptr<eunomia::TiledImageBuffer<C_>>
+reduce_(const eunomia::TiledImageBuffer<C_>& src, int w, int h) noexcept
+{
+  using Tiled = eunomia::TiledImageBuffer<C_>;
+
+  auto res = Tiled::create(w, h, eunomia::InitPolicy::Uninitialized);
+  if (!res)
+    return nullptr;
+
+  // 元サイズ/縮小サイズ
+  double dw = (double)src.width() / (double)w;
+  double dh = (double)src.height() / (double)h;
+
+  for (int ty = 0; ty < res->tileRows(); ++ty) {
+    int Y0 = ty << Tiled::TILE_SHIFT;
+    int nY = std::min(Tiled::TILE_SIZE, h - Y0);
+
+    for (int tx = 0; tx < res->tileColumns(); ++tx) {
+      int X0 = tx << Tiled::TILE_SHIFT;
+      int nX = std::min(Tiled::TILE_SIZE, w - X0);
+
+      for (int j = 0; j < nY; ++j) {
+        double y1 = (Y0 + j) * dh;
+        double y2 = (Y0 + j + 1) * dh;
+        if (y2 > src.height()) {
+          // 原畫像からはみ出す部分はPicture::reduce()と同じ畫素値にしておく
+          for (; j < nY; ++j)
+            std::fill_n(res->tileLine(tx, ty, j), nX, C_());
+          break;
+        }
+
+        C_* d = res->tileLine(tx, ty, j);
+        for (int i = 0; i < nX; ++i) {
+          double x1 = (double)(X0 + i) * dw;
+          double x2 = (double)(X0 + i + 1) * dw;
+          if (x2 > src.width()) {
+            std::fill(d + i, d + nX, C_());
+            break;
+          }
+
+          d[i] = condense_(src, x1, y1, x2, y2);
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
+
+}// end of NONAME namespace
+
+
+std::unique_ptr<eunomia::TiledImageBuffer<eunomia::RgbColour>>
+eunomia::reduce(
+  const eunomia::TiledImageBuffer<eunomia::RgbColour>& src, int w, int h)
+  noexcept
+{
+  return reduce_(src, w, h);
+}
+
+
+std::unique_ptr<eunomia::TiledImageBuffer<eunomia::RgbaColour>>
+eunomia::reduce(
+  const eunomia::TiledImageBuffer<eunomia::RgbaColour>& src, int w, int h)
+  noexcept
+{
+  return reduce_(src, w, h);
+}
+
+
+
+
+//eof